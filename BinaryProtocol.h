@@ -0,0 +1,320 @@
+#ifndef BINARYPROTOCOL_H
+#define BINARYPROTOCOL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file BinaryProtocol.h
+ * @brief The fixed-layout binary frames of the "connect-four.bin.v1" WebSocket subprotocol.
+ *
+ * A client that offers BINARY_SUBPROTOCOL in its handshake and gets it back from the
+ * server plays with binary WebSocket frames instead of JSON text messages. The
+ * player_name message stays JSON in both protocols. Every frame starts with its
+ * FrameType byte, followed by the fields of its struct in declaration order; multi-byte
+ * fields are little-endian. Rows are counted from the top of the board, as in the JSON board.
+ *
+ * A move_result carries the move instead of the board, so a binary client keeps its own
+ * copy of the board and applies every move_result to it. Moves are numbered by seq, the
+ * number of discs on the board after the move; a client that misses one asks for a board
+ * frame with a board_request.
+ */
+
+static constexpr const char* BINARY_SUBPROTOCOL = "connect-four.bin.v1"; /**< The subprotocol name negotiated in the handshake. */
+
+/**
+ * @enum FrameType
+ * @brief The first byte of every binary frame.
+ */
+enum class FrameType : uint8_t {
+    MOVE = 1,        /**< Client to server: the column the client plays. */
+    MOVE_RESULT = 2, /**< Server to client: a move that was played, or the client's move being rejected. */
+    YOUR_TURN = 3,   /**< Server to client: the client is to move. */
+    GAME_OVER = 4,   /**< Server to client: the game has ended. */
+    GAME_START = 5,  /**< Server to client: the size of the board, sent once the player name is received. */
+    BOARD = 6,       /**< Server to client: a snapshot of the board, sent on join and on request. */
+    BOARD_REQUEST = 7 /**< Client to server: asks for a board frame. */
+};
+
+/**
+ * @enum MoveStatus
+ * @brief Whether a move_result reports a move or a rejected move.
+ */
+enum class MoveStatus : uint8_t {
+    PLAYED = 0,  /**< The move was played. */
+    INVALID = 1  /**< The client's move was rejected; the client is still to move. */
+};
+
+/**
+ * @struct MoveFrame
+ * @brief A move frame: 2 bytes.
+ */
+struct MoveFrame {
+    static constexpr FrameType TYPE = FrameType::MOVE; /**< The frame type. */
+    static constexpr size_t SIZE = 2; /**< The encoded size in bytes. */
+    uint8_t column = 0; /**< The column played. */
+};
+
+/**
+ * @struct MoveResultFrame
+ * @brief A move_result frame: 7 bytes.
+ */
+struct MoveResultFrame {
+    static constexpr FrameType TYPE = FrameType::MOVE_RESULT; /**< The frame type. */
+    static constexpr size_t SIZE = 7; /**< The encoded size in bytes. */
+    MoveStatus status = MoveStatus::PLAYED; /**< Whether the move was played. */
+    uint8_t column = 0; /**< The column played. */
+    uint8_t row = 0; /**< The row the disc landed in, counted from the top. */
+    uint8_t player = 0; /**< The player who moved. */
+    uint16_t seq = 0; /**< The sequence number of the move, the number of discs on the board after it. */
+};
+
+/**
+ * @struct YourTurnFrame
+ * @brief A your_turn frame: 1 byte.
+ */
+struct YourTurnFrame {
+    static constexpr FrameType TYPE = FrameType::YOUR_TURN; /**< The frame type. */
+    static constexpr size_t SIZE = 1; /**< The encoded size in bytes. */
+};
+
+/**
+ * @struct GameOverFrame
+ * @brief A game_over frame: 4 bytes.
+ */
+struct GameOverFrame {
+    static constexpr FrameType TYPE = FrameType::GAME_OVER; /**< The frame type. */
+    static constexpr size_t SIZE = 4; /**< The encoded size in bytes. */
+    uint8_t winner = 0; /**< The winning player, 0 for a draw. */
+    uint16_t seq = 0; /**< The sequence number of the last move. */
+};
+
+/**
+ * @struct GameStartFrame
+ * @brief A game_start frame: 4 bytes.
+ */
+struct GameStartFrame {
+    static constexpr FrameType TYPE = FrameType::GAME_START; /**< The frame type. */
+    static constexpr size_t SIZE = 4; /**< The encoded size in bytes. */
+    uint8_t rows = 0; /**< The number of rows on the board. */
+    uint8_t columns = 0; /**< The number of columns on the board. */
+    uint8_t win_condition = 0; /**< The number of discs in a row needed to win. */
+};
+
+/**
+ * @struct BoardFrame
+ * @brief A board frame: a 5-byte header followed by the cells, 2 bits each.
+ *
+ * The cells are packed row by row from the top, least significant bits first.
+ */
+struct BoardFrame {
+    static constexpr FrameType TYPE = FrameType::BOARD; /**< The frame type. */
+    static constexpr size_t HEADER_SIZE = 5; /**< The encoded size of the header in bytes. */
+    uint8_t rows = 0; /**< The number of rows on the board. */
+    uint8_t columns = 0; /**< The number of columns on the board. */
+    uint16_t seq = 0; /**< The sequence number of the last move on the board. */
+    std::vector<uint8_t> cells; /**< The player in each cell, row by row from the top. */
+};
+
+/**
+ * @struct BoardRequestFrame
+ * @brief A board_request frame: 1 byte.
+ */
+struct BoardRequestFrame {
+    static constexpr FrameType TYPE = FrameType::BOARD_REQUEST; /**< The frame type. */
+    static constexpr size_t SIZE = 1; /**< The encoded size in bytes. */
+};
+
+/**
+ * @brief Gets the type of a binary frame.
+ * @param payload The frame.
+ * @return The type, or 0 if the frame is empty.
+ */
+inline FrameType frame_type(const std::string& payload) {
+    return payload.empty() ? FrameType{} : static_cast<FrameType>(payload[0]);
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, MoveFrame::SIZE> encode_frame(const MoveFrame& frame) {
+    return {static_cast<uint8_t>(MoveFrame::TYPE), frame.column};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, MoveResultFrame::SIZE> encode_frame(const MoveResultFrame& frame) {
+    return {static_cast<uint8_t>(MoveResultFrame::TYPE), static_cast<uint8_t>(frame.status), frame.column, frame.row,
+            frame.player, static_cast<uint8_t>(frame.seq), static_cast<uint8_t>(frame.seq >> 8)};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, YourTurnFrame::SIZE> encode_frame(const YourTurnFrame&) {
+    return {static_cast<uint8_t>(YourTurnFrame::TYPE)};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, GameOverFrame::SIZE> encode_frame(const GameOverFrame& frame) {
+    return {static_cast<uint8_t>(GameOverFrame::TYPE), frame.winner,
+            static_cast<uint8_t>(frame.seq), static_cast<uint8_t>(frame.seq >> 8)};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, GameStartFrame::SIZE> encode_frame(const GameStartFrame& frame) {
+    return {static_cast<uint8_t>(GameStartFrame::TYPE), frame.rows, frame.columns, frame.win_condition};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame.
+ * @return The encoded bytes.
+ */
+inline std::array<uint8_t, BoardRequestFrame::SIZE> encode_frame(const BoardRequestFrame&) {
+    return {static_cast<uint8_t>(BoardRequestFrame::TYPE)};
+}
+
+/**
+ * @brief Encodes a frame.
+ * @param frame The frame, with rows * columns cells.
+ * @return The encoded bytes.
+ */
+inline std::vector<uint8_t> encode_frame(const BoardFrame& frame) {
+    std::vector<uint8_t> bytes(BoardFrame::HEADER_SIZE + (frame.cells.size() + 3) / 4, 0);
+    bytes[0] = static_cast<uint8_t>(BoardFrame::TYPE);
+    bytes[1] = frame.rows;
+    bytes[2] = frame.columns;
+    bytes[3] = static_cast<uint8_t>(frame.seq);
+    bytes[4] = static_cast<uint8_t>(frame.seq >> 8);
+    for (size_t i = 0; i < frame.cells.size(); ++i) {
+        bytes[BoardFrame::HEADER_SIZE + i / 4] |= static_cast<uint8_t>((frame.cells[i] & 3) << (i % 4 * 2));
+    }
+    return bytes;
+}
+
+/**
+ * @brief Checks that a payload has the type and size of a frame.
+ * @tparam Frame The expected frame struct.
+ * @param payload The payload.
+ * @return The bytes of the payload, or nullptr if it is not such a frame.
+ */
+template <typename Frame>
+inline const uint8_t* frame_bytes(const std::string& payload) {
+    if (payload.size() != Frame::SIZE || frame_type(payload) != Frame::TYPE) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t*>(payload.data());
+}
+
+/**
+ * @brief Decodes a frame.
+ * @param payload The payload of a binary message.
+ * @param frame Receives the frame.
+ * @return True if the payload is a well-formed frame of this type, false otherwise.
+ */
+inline bool decode_frame(const std::string& payload, MoveFrame& frame) {
+    const uint8_t* bytes = frame_bytes<MoveFrame>(payload);
+    if (!bytes) {
+        return false;
+    }
+    frame.column = bytes[1];
+    return true;
+}
+
+/**
+ * @brief Decodes a frame.
+ * @param payload The payload of a binary message.
+ * @param frame Receives the frame.
+ * @return True if the payload is a well-formed frame of this type, false otherwise.
+ */
+inline bool decode_frame(const std::string& payload, MoveResultFrame& frame) {
+    const uint8_t* bytes = frame_bytes<MoveResultFrame>(payload);
+    if (!bytes) {
+        return false;
+    }
+    frame.status = static_cast<MoveStatus>(bytes[1]);
+    frame.column = bytes[2];
+    frame.row = bytes[3];
+    frame.player = bytes[4];
+    frame.seq = static_cast<uint16_t>(bytes[5] | (bytes[6] << 8));
+    return true;
+}
+
+/**
+ * @brief Decodes a frame.
+ * @param payload The payload of a binary message.
+ * @param frame Receives the frame.
+ * @return True if the payload is a well-formed frame of this type, false otherwise.
+ */
+inline bool decode_frame(const std::string& payload, GameOverFrame& frame) {
+    const uint8_t* bytes = frame_bytes<GameOverFrame>(payload);
+    if (!bytes) {
+        return false;
+    }
+    frame.winner = bytes[1];
+    frame.seq = static_cast<uint16_t>(bytes[2] | (bytes[3] << 8));
+    return true;
+}
+
+/**
+ * @brief Decodes a frame.
+ * @param payload The payload of a binary message.
+ * @param frame Receives the frame.
+ * @return True if the payload is a well-formed frame of this type, false otherwise.
+ */
+inline bool decode_frame(const std::string& payload, GameStartFrame& frame) {
+    const uint8_t* bytes = frame_bytes<GameStartFrame>(payload);
+    if (!bytes) {
+        return false;
+    }
+    frame.rows = bytes[1];
+    frame.columns = bytes[2];
+    frame.win_condition = bytes[3];
+    return true;
+}
+
+/**
+ * @brief Decodes a frame.
+ * @param payload The payload of a binary message.
+ * @param frame Receives the frame.
+ * @return True if the payload is a well-formed frame of this type, false otherwise.
+ */
+inline bool decode_frame(const std::string& payload, BoardFrame& frame) {
+    if (payload.size() < BoardFrame::HEADER_SIZE || frame_type(payload) != BoardFrame::TYPE) {
+        return false;
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(payload.data());
+    size_t cells = static_cast<size_t>(bytes[1]) * bytes[2];
+    if (payload.size() != BoardFrame::HEADER_SIZE + (cells + 3) / 4) {
+        return false;
+    }
+    frame.rows = bytes[1];
+    frame.columns = bytes[2];
+    frame.seq = static_cast<uint16_t>(bytes[3] | (bytes[4] << 8));
+    frame.cells.resize(cells);
+    for (size_t i = 0; i < cells; ++i) {
+        frame.cells[i] = (bytes[BoardFrame::HEADER_SIZE + i / 4] >> (i % 4 * 2)) & 3;
+    }
+    return true;
+}
+
+#endif // BINARYPROTOCOL_H
@@ -1,13 +1,14 @@
 #ifndef CONNECTFOURGAME_H
 #define CONNECTFOURGAME_H
 
-#include <vector>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 #include <json/json.h>
 
-const int ROWS = 6;
-const int COLUMNS = 7;
-const int WIN_CONDITION = 4;
-
 /**
  * @enum Player
  * @brief Represents the players in the game.
@@ -21,9 +22,32 @@ enum Player {
 /**
  * @class ConnectFourGame
  * @brief A class representing the Connect Four game logic.
+ *
+ * The board geometry is fixed at compile time, so bitboard masks, loop bounds and
+ * win-check shifts are all constants. Boards of up to 64 bits use a single
+ * uint64_t bitboard, larger ones fall back to std::bitset.
+ *
+ * @tparam Rows The number of rows on the board.
+ * @tparam Cols The number of columns on the board.
+ * @tparam K The number of discs in a row needed to win.
  */
+template <int Rows, int Cols, int K>
 class ConnectFourGame {
 public:
+    static constexpr int ROWS = Rows; /**< The number of rows on the board. */
+    static constexpr int COLUMNS = Cols; /**< The number of columns on the board. */
+    static constexpr int WIN_CONDITION = K; /**< The number of discs in a row needed to win. */
+    static constexpr int CELLS = Cols * (Rows + 1); /**< The number of bits in a bitboard, sentinels included. */
+
+    /**
+     * Bitboard layout: each column occupies ROWS + 1 consecutive bits, bottom cell first,
+     * with one spare sentinel bit on top so that shifts never carry into the next column.
+     */
+    using Bitboard = std::conditional_t<CELLS <= 64, uint64_t, std::bitset<CELLS>>;
+
+    static_assert(Rows >= K || Cols >= K, "The board is too small to ever win.");
+    static_assert(K >= 4, "The line masks of last_move_wins require a win condition of at least 4.");
+
     /**
      * @brief Constructor for the ConnectFourGame class. Initializes the game board.
      */
@@ -37,6 +61,77 @@ public:
      */
     bool make_move(Player player, int column);
 
+    /**
+     * @brief Takes back the last move made.
+     * @return True if a move was taken back, false if the board is empty.
+     */
+    bool undo_move();
+
+    /**
+     * @brief Checks if every cell of the board is occupied.
+     * @return True if no more moves can be made, false otherwise.
+     */
+    bool is_full() const;
+
+    /**
+     * @brief Gets the number of discs on the board.
+     * @return The number of moves made so far.
+     */
+    int move_count() const;
+
+    /**
+     * @brief Gets the columns played so far.
+     * @return The columns in the order they were played.
+     */
+    std::span<const uint8_t> move_history() const;
+
+    /**
+     * @brief Gets the number of discs in a column.
+     * @param column The column index.
+     * @return The height of the column.
+     */
+    int column_height(int column) const;
+
+    /**
+     * @brief Gets the Zobrist hash of the current position.
+     *
+     * The hash only depends on which player occupies which cell, so move orders that
+     * reach the same position share a hash. It is updated in O(1) by make_move and undo_move.
+     * @return The 64-bit position hash.
+     */
+    uint64_t hash() const;
+
+    /**
+     * @brief Gets the Zobrist hash of the current position mirrored left to right.
+     * @return The hash the mirrored position would have.
+     */
+    uint64_t mirrored_hash() const;
+
+    /**
+     * @brief Gets the hash shared by the position and its mirror image.
+     *
+     * The game is left-right symmetric, so a position and its mirror have the same score
+     * and mirrored best moves. Keying caches on this hash lets both share one entry; moves
+     * read from or written to such caches go through canonical_column.
+     * @return The smaller of hash() and mirrored_hash().
+     */
+    uint64_t canonical_hash() const;
+
+    /**
+     * @brief Checks if the canonical orientation of the position is its mirror image.
+     * @return True if canonical_hash() is the mirrored hash, false otherwise.
+     */
+    bool is_mirrored() const;
+
+    /**
+     * @brief Maps a column between the board and its canonical orientation.
+     *
+     * The mapping is its own inverse, so it converts moves in both directions.
+     * @param column The column index, or -1 for no move.
+     * @return The column mirrored if is_mirrored(), otherwise the column unchanged.
+     */
+    int canonical_column(int column) const;
+
     /**
      * @brief Checks if the specified player has won the game.
      * @param player The player to check for a win condition.
@@ -44,6 +139,19 @@ public:
      */
     bool check_winner(Player player) const;
 
+    /**
+     * @brief Checks if the last disc dropped completed a line, looking only at the lines through it.
+     * @return True if the last move won the game, false otherwise.
+     */
+    bool last_move_wins() const;
+
+    /**
+     * @brief Checks a bitboard for WIN_CONDITION discs in a row in any direction.
+     * @param discs The bitboard of one player's discs.
+     * @return True if the bitboard contains a winning line, false otherwise.
+     */
+    static bool has_alignment(const Bitboard& discs);
+
     /**
      * @brief Prints the current state of the game board.
      */
@@ -55,21 +163,385 @@ public:
      */
     Json::Value get_board_json() const;
 
+    /**
+     * @brief Gets the player occupying a cell.
+     * @param row The row index, counted from the top of the board.
+     * @param column The column index.
+     * @return The player in the cell, or Player::NONE if it is empty.
+     */
+    Player cell(int row, int column) const;
+
 private:
-    std::vector<std::vector<int>> board; /**< The game board represented as a 2D vector. */
-    int last_move_row = -1; /**< The row index of the last move made. */
-    int last_move_col = -1; /**< The column index of the last move made. */
+    Bitboard position{}; /**< Bitboard of the cells occupied by the client. */
+    Bitboard mask{}; /**< Bitboard of all occupied cells. */
+    std::array<uint8_t, Cols> heights{}; /**< The number of discs in each column. */
+    std::array<uint8_t, Rows * Cols> history{}; /**< The columns played so far, in order. */
+    int moves = 0; /**< The number of moves in the history. */
+    uint64_t zobrist = 0; /**< The Zobrist hash of the position. */
+    uint64_t mirror_zobrist = 0; /**< The Zobrist hash of the mirrored position. */
 
     /**
-     * @brief Checks a specific direction for a win condition starting from a given position.
-     * @param player The player to check for a win condition.
-     * @param row The starting row index.
-     * @param column The starting column index.
-     * @param d_row The row direction to check.
-     * @param d_col The column direction to check.
-     * @return True if a win condition is met in the specified direction, false otherwise.
+     * @brief Gets the bitboard index of the last disc dropped.
+     * @return The cell index, or -1 if the board is empty.
+     */
+    int last_move_cell() const;
+
+    /**
+     * @brief Gets the bitboard with a single cell set.
+     * @param index The bitboard index of the cell.
+     * @return The single-cell bitboard.
+     */
+    static Bitboard bit(int index);
+
+    /**
+     * @brief Checks if a bitboard has any cell set.
+     * @param board The bitboard to check.
+     * @return True if at least one cell is set, false otherwise.
      */
-    bool check_direction(Player player, int row, int column, int d_row, int d_col) const;
+    static bool any(const Bitboard& board);
+
+    /**
+     * @brief Builds, for every cell, the bitboard of the cells on the lines through it.
+     * @return The table of line masks indexed by bitboard cell index.
+     *
+     * For WIN_CONDITION >= 4, no line other than the four through the cell can hold
+     * WIN_CONDITION cells of this mask, so an alignment check on the masked discs only
+     * finds lines that contain the cell.
+     */
+    static std::array<Bitboard, CELLS> make_line_masks();
+
+    /**
+     * @brief Generates the Zobrist keys with a fixed-seed splitmix64 sequence.
+     * @return The keys of the client's cells followed by the keys of the server's cells.
+     */
+    static constexpr std::array<uint64_t, 2 * CELLS> make_zobrist_keys();
+
+    /**
+     * @brief Gets the Zobrist key of a disc.
+     * @param client True for a client disc, false for a server disc.
+     * @param index The bitboard index of the cell.
+     * @return The Zobrist key.
+     */
+    static uint64_t zobrist_key(bool client, int index);
+
+    static inline const std::array<Bitboard, CELLS> line_masks = make_line_masks(); /**< Lines through each cell. */
+    static constexpr std::array<uint64_t, 2 * CELLS> zobrist_keys = make_zobrist_keys(); /**< Zobrist keys per player and cell. */
 };
 
-#endif // CONNECTFOURGAME_H 
\ No newline at end of file
+/**
+ * @brief Constructor for the ConnectFourGame class. Initializes the game board.
+ */
+template <int Rows, int Cols, int K>
+ConnectFourGame<Rows, Cols, K>::ConnectFourGame() {}
+
+/**
+ * @brief Makes a move for the specified player in the given column.
+ * @param player The player making the move.
+ * @param column The column where the disc should be dropped.
+ * @return True if the move is valid and successful, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::make_move(Player player, int column) {
+    if (column < 0 || column >= COLUMNS || heights[column] == ROWS)
+        return false;
+
+    int index = column * (ROWS + 1) + heights[column]++;
+    Bitboard move = bit(index);
+    mask |= move;
+    if (player == Player::CLIENT)
+        position |= move;
+    zobrist ^= zobrist_key(player == Player::CLIENT, index);
+    mirror_zobrist ^= zobrist_key(player == Player::CLIENT, index + (COLUMNS - 1 - 2 * column) * (ROWS + 1));
+    history[moves++] = static_cast<uint8_t>(column);
+    return true;
+}
+
+/**
+ * @brief Takes back the last move made.
+ * @return True if a move was taken back, false if the board is empty.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::undo_move() {
+    if (moves == 0)
+        return false;
+
+    int column = history[--moves];
+    int index = column * (ROWS + 1) + --heights[column];
+    Bitboard move = bit(index);
+    bool client = any(position & move);
+    zobrist ^= zobrist_key(client, index);
+    mirror_zobrist ^= zobrist_key(client, index + (COLUMNS - 1 - 2 * column) * (ROWS + 1));
+    Bitboard keep = ~move;
+    mask &= keep;
+    position &= keep;
+    return true;
+}
+
+/**
+ * @brief Checks if every cell of the board is occupied.
+ * @return True if no more moves can be made, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::is_full() const {
+    return moves == ROWS * COLUMNS;
+}
+
+/**
+ * @brief Gets the number of discs on the board.
+ * @return The number of moves made so far.
+ */
+template <int Rows, int Cols, int K>
+inline int ConnectFourGame<Rows, Cols, K>::move_count() const {
+    return moves;
+}
+
+/**
+ * @brief Gets the columns played so far.
+ * @return The columns in the order they were played.
+ */
+template <int Rows, int Cols, int K>
+inline std::span<const uint8_t> ConnectFourGame<Rows, Cols, K>::move_history() const {
+    return std::span<const uint8_t>(history.data(), moves);
+}
+
+/**
+ * @brief Gets the number of discs in a column.
+ * @param column The column index.
+ * @return The height of the column.
+ */
+template <int Rows, int Cols, int K>
+inline int ConnectFourGame<Rows, Cols, K>::column_height(int column) const {
+    return heights[column];
+}
+
+/**
+ * @brief Gets the Zobrist hash of the current position.
+ * @return The 64-bit position hash.
+ */
+template <int Rows, int Cols, int K>
+inline uint64_t ConnectFourGame<Rows, Cols, K>::hash() const {
+    return zobrist;
+}
+
+/**
+ * @brief Gets the Zobrist hash of the current position mirrored left to right.
+ * @return The hash the mirrored position would have.
+ */
+template <int Rows, int Cols, int K>
+inline uint64_t ConnectFourGame<Rows, Cols, K>::mirrored_hash() const {
+    return mirror_zobrist;
+}
+
+/**
+ * @brief Gets the hash shared by the position and its mirror image.
+ * @return The smaller of hash() and mirrored_hash().
+ */
+template <int Rows, int Cols, int K>
+inline uint64_t ConnectFourGame<Rows, Cols, K>::canonical_hash() const {
+    return mirror_zobrist < zobrist ? mirror_zobrist : zobrist;
+}
+
+/**
+ * @brief Checks if the canonical orientation of the position is its mirror image.
+ * @return True if canonical_hash() is the mirrored hash, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::is_mirrored() const {
+    return mirror_zobrist < zobrist;
+}
+
+/**
+ * @brief Maps a column between the board and its canonical orientation.
+ * @param column The column index, or -1 for no move.
+ * @return The column mirrored if is_mirrored(), otherwise the column unchanged.
+ */
+template <int Rows, int Cols, int K>
+inline int ConnectFourGame<Rows, Cols, K>::canonical_column(int column) const {
+    return column >= 0 && is_mirrored() ? COLUMNS - 1 - column : column;
+}
+
+/**
+ * @brief Checks if the specified player has won the game.
+ * @param player The player to check for a win condition.
+ * @return True if the player has won, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::check_winner(Player player) const {
+    if (player == Player::NONE)
+        return false;
+    return has_alignment(player == Player::CLIENT ? position : position ^ mask);
+}
+
+/**
+ * @brief Checks if the last disc dropped completed a line, looking only at the lines through it.
+ * @return True if the last move won the game, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::last_move_wins() const {
+    int cell_index = last_move_cell();
+    if (cell_index < 0)
+        return false;
+    Bitboard discs = any(position & bit(cell_index)) ? position : position ^ mask;
+    return has_alignment(discs & line_masks[cell_index]);
+}
+
+/**
+ * @brief Checks a bitboard for WIN_CONDITION discs in a row in any direction.
+ * @param discs The bitboard of one player's discs.
+ * @return True if the bitboard contains a winning line, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::has_alignment(const Bitboard& discs) {
+    // Bitboard distances between neighbouring cells: vertical, diagonal down, horizontal, diagonal up.
+    constexpr int shifts[4] = {1, ROWS, ROWS + 1, ROWS + 2};
+    Bitboard lines{};
+    for (int shift : shifts) {
+        Bitboard run = discs;
+        for (int i = 1; i < WIN_CONDITION; ++i)
+            run &= discs >> (i * shift);
+        lines |= run;
+    }
+    return any(lines);
+}
+
+/**
+ * @brief Gets the bitboard index of the last disc dropped.
+ * @return The cell index, or -1 if the board is empty.
+ */
+template <int Rows, int Cols, int K>
+inline int ConnectFourGame<Rows, Cols, K>::last_move_cell() const {
+    if (moves == 0)
+        return -1;
+    int column = history[moves - 1];
+    return column * (ROWS + 1) + heights[column] - 1;
+}
+
+/**
+ * @brief Gets the player occupying a cell.
+ * @param row The row index, counted from the top of the board.
+ * @param column The column index.
+ * @return The player in the cell, or Player::NONE if it is empty.
+ */
+template <int Rows, int Cols, int K>
+inline Player ConnectFourGame<Rows, Cols, K>::cell(int row, int column) const {
+    Bitboard cell_bit = bit(ROWS - 1 - row + column * (ROWS + 1));
+    if (!any(mask & cell_bit))
+        return Player::NONE;
+    return any(position & cell_bit) ? Player::CLIENT : Player::SERVER;
+}
+
+/**
+ * @brief Gets the bitboard with a single cell set.
+ * @param index The bitboard index of the cell.
+ * @return The single-cell bitboard.
+ */
+template <int Rows, int Cols, int K>
+inline typename ConnectFourGame<Rows, Cols, K>::Bitboard ConnectFourGame<Rows, Cols, K>::bit(int index) {
+    return Bitboard(1) << index;
+}
+
+/**
+ * @brief Checks if a bitboard has any cell set.
+ * @param board The bitboard to check.
+ * @return True if at least one cell is set, false otherwise.
+ */
+template <int Rows, int Cols, int K>
+inline bool ConnectFourGame<Rows, Cols, K>::any(const Bitboard& board) {
+    if constexpr (std::is_integral_v<Bitboard>)
+        return board != 0;
+    else
+        return board.any();
+}
+
+/**
+ * @brief Builds, for every cell, the bitboard of the cells on the lines through it.
+ * @return The table of line masks indexed by bitboard cell index.
+ */
+template <int Rows, int Cols, int K>
+std::array<typename ConnectFourGame<Rows, Cols, K>::Bitboard, ConnectFourGame<Rows, Cols, K>::CELLS>
+ConnectFourGame<Rows, Cols, K>::make_line_masks() {
+    std::array<Bitboard, CELLS> masks{};
+    const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}}; // {d_col, d_height}
+    for (int column = 0; column < COLUMNS; ++column) {
+        for (int height = 0; height < ROWS; ++height) {
+            Bitboard lines{};
+            for (const auto& direction : directions) {
+                for (int i = -WIN_CONDITION + 1; i < WIN_CONDITION; ++i) {
+                    int c = column + i * direction[0];
+                    int h = height + i * direction[1];
+                    if (c >= 0 && c < COLUMNS && h >= 0 && h < ROWS)
+                        lines |= bit(h + c * (ROWS + 1));
+                }
+            }
+            masks[height + column * (ROWS + 1)] = lines;
+        }
+    }
+    return masks;
+}
+
+/**
+ * @brief Generates the Zobrist keys with a fixed-seed splitmix64 sequence.
+ * @return The keys of the client's cells followed by the keys of the server's cells.
+ */
+template <int Rows, int Cols, int K>
+constexpr std::array<uint64_t, 2 * ConnectFourGame<Rows, Cols, K>::CELLS> ConnectFourGame<Rows, Cols, K>::make_zobrist_keys() {
+    std::array<uint64_t, 2 * CELLS> keys{};
+    uint64_t state = UINT64_C(0x9E3779B97F4A7C15) * (Rows * 100 + Cols * 10 + K);
+    for (auto& key : keys) {
+        uint64_t z = (state += UINT64_C(0x9E3779B97F4A7C15));
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        key = z ^ (z >> 31);
+    }
+    return keys;
+}
+
+/**
+ * @brief Gets the Zobrist key of a disc.
+ * @param client True for a client disc, false for a server disc.
+ * @param index The bitboard index of the cell.
+ * @return The Zobrist key.
+ */
+template <int Rows, int Cols, int K>
+inline uint64_t ConnectFourGame<Rows, Cols, K>::zobrist_key(bool client, int index) {
+    return zobrist_keys[(client ? 0 : CELLS) + index];
+}
+
+using StandardConnectFour = ConnectFourGame<6, 7, 4>; /**< The classic 6x7 connect-4 board. */
+using LargeConnectFour = ConnectFourGame<7, 8, 4>; /**< The 7x8 connect-4 board. */
+using GiantConnectFour = ConnectFourGame<8, 9, 4>; /**< The 8x9 connect-4 board. */
+using ConnectFive = ConnectFourGame<6, 9, 5>; /**< The 6x9 connect-5 board. */
+
+extern template class ConnectFourGame<6, 7, 4>;
+extern template class ConnectFourGame<7, 8, 4>;
+extern template class ConnectFourGame<8, 9, 4>;
+extern template class ConnectFourGame<6, 9, 5>;
+
+/**
+ * @brief Calls a function with the game type whose geometry matches the given one.
+ *
+ * Only the explicitly instantiated variants are available. The function receives a
+ * std::type_identity tag of the selected ConnectFourGame type.
+ * @param rows The number of rows on the board.
+ * @param columns The number of columns on the board.
+ * @param win_condition The number of discs in a row needed to win.
+ * @param function The function to call with the selected game type.
+ * @return True if a matching variant was found and the function was called, false otherwise.
+ */
+template <typename Function>
+bool dispatch_game_variant(int rows, int columns, int win_condition, Function&& function) {
+    if (rows == 6 && columns == 7 && win_condition == 4) {
+        function(std::type_identity<StandardConnectFour>{});
+    } else if (rows == 7 && columns == 8 && win_condition == 4) {
+        function(std::type_identity<LargeConnectFour>{});
+    } else if (rows == 8 && columns == 9 && win_condition == 4) {
+        function(std::type_identity<GiantConnectFour>{});
+    } else if (rows == 6 && columns == 9 && win_condition == 5) {
+        function(std::type_identity<ConnectFive>{});
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif // CONNECTFOURGAME_H
\ No newline at end of file
@@ -1,86 +1,551 @@
 #include "DatabaseManager.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
+static const char* const BEGIN_SQL = "BEGIN;";
+static const char* const COMMIT_SQL = "COMMIT;";
+static const char* const ROLLBACK_SQL = "ROLLBACK;";
+static const char* const COLUMN_EXISTS_SQL = "SELECT 1 FROM pragma_table_info(?) WHERE name = ?;";
+static const char* const SELECT_PLAYER_SQL = "SELECT elo, games, last_seen, rd, volatility FROM players WHERE name = ?;";
+static const char* const UPSERT_PLAYER_SQL = "INSERT INTO players (name, elo, games, last_seen) VALUES (?1, 100 + ?2, ?3, ?4) "
+                                             "ON CONFLICT(name) DO UPDATE SET elo = elo + ?2, games = games + ?3, "
+                                             "last_seen = MAX(last_seen, ?4);";
+static const char* const STORE_RATING_SQL = "INSERT INTO players (name, elo, rd, volatility) VALUES (?1, ?2, ?3, ?4) "
+                                            "ON CONFLICT(name) DO UPDATE SET elo = ?2, rd = ?3, volatility = ?4;";
+static const char* const INSERT_GAME_SQL = "INSERT INTO games (player, opponent, score, played_at, started_at, rows, "
+                                           "columns, win_condition, move_count, moves) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+static const char* const SELECT_GAME_SQL = "SELECT player, opponent, score, played_at, started_at, rows, columns, "
+                                           "win_condition, move_count, moves FROM games WHERE id = ?;";
+
 /**
- * @brief Constructor for the DatabaseManager class. Initializes the database connection.
+ * @brief Constructor for the DatabaseManager class. Initializes the database connections and starts the rating writer.
+ * @param config The database settings.
  */
-DatabaseManager::DatabaseManager() : db(nullptr) {
+DatabaseManager::DatabaseManager(const DatabaseConfig& config)
+    : config(config), db(nullptr), flush_interval(std::max(1, config.flush_interval_ms)),
+      cache(std::max(0, config.player_cache_size)) {
+    this->config.batch_size = std::max(1, config.batch_size);
+    this->config.queue_capacity = std::max(1, config.queue_capacity);
+    this->config.read_connections = std::max(1, config.read_connections);
     init_database();
+    if (!config.read_only) {
+        writer = std::thread(&DatabaseManager::run_writer, this);
+    }
 }
 
 /**
- * @brief Destructor for the DatabaseManager class. Closes the database connection.
+ * @brief Destructor for the DatabaseManager class. Commits the queued rating updates and closes the database connections.
  */
 DatabaseManager::~DatabaseManager() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    writer_cv.notify_one();
+    progress_cv.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    for (auto& reader : readers) {
+        reader->statements.attach(nullptr);
+        sqlite3_close(reader->db);
+    }
+    statements.attach(nullptr);
     if (db) {
         sqlite3_close(db);
     }
 }
 
 /**
- * @brief Initializes the database, creating necessary tables if they do not exist.
+ * @brief Initializes the database, creating necessary tables if they do not exist, and opens the read connections.
  */
 void DatabaseManager::init_database() {
-    int rc = sqlite3_open("connect_four.db", &db);
-    if (rc) {
-        std::cerr << "Can't open database: " << sqlite3_errmsg(db) << std::endl;
+    if (!config.read_only) {
+        init_writer_connection();
+    }
+
+    for (int i = 0; i < config.read_connections; ++i) {
+        auto reader = std::make_unique<ReadConnection>();
+        reader->db = open_connection(SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+        if (!reader->db) {
+            break;
+        }
+        reader->statements.attach(reader->db);
+        reader->statements.get(SELECT_PLAYER_SQL);
+        readers.push_back(std::move(reader));
+    }
+}
+
+/**
+ * @brief Checks whether the database could be opened.
+ * @return True if lookups can reach the database, false otherwise.
+ */
+bool DatabaseManager::is_open() const {
+    return !readers.empty();
+}
+
+/**
+ * @brief Opens the read-write connection, creating the database and its tables if they do not exist.
+ */
+void DatabaseManager::init_writer_connection() {
+    // Each connection is only ever used by one thread at a time, so SQLite's own locking is not needed.
+    db = open_connection(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+    if (!db) {
         return;
     }
 
+    std::string pragmas = "PRAGMA journal_mode = " + config.journal_mode + ";"
+                          "PRAGMA synchronous = " + config.synchronous + ";";
     const char* sql = "CREATE TABLE IF NOT EXISTS players ("
                       "name TEXT PRIMARY KEY, "
-                      "elo INTEGER DEFAULT 100);";
+                      "elo INTEGER DEFAULT 100, "
+                      "games INTEGER NOT NULL DEFAULT 0, "
+                      "last_seen INTEGER NOT NULL DEFAULT 0, "
+                      "rd REAL NOT NULL DEFAULT 350, "
+                      "volatility REAL NOT NULL DEFAULT 0.06);"
+                      "CREATE TABLE IF NOT EXISTS games ("
+                      "id INTEGER PRIMARY KEY, "
+                      "player TEXT NOT NULL, "
+                      "opponent TEXT NOT NULL, "
+                      "score REAL NOT NULL, "
+                      "played_at INTEGER NOT NULL, "
+                      "started_at INTEGER NOT NULL DEFAULT 0, "
+                      "rows INTEGER NOT NULL DEFAULT 0, "
+                      "columns INTEGER NOT NULL DEFAULT 0, "
+                      "win_condition INTEGER NOT NULL DEFAULT 0, "
+                      "move_count INTEGER NOT NULL DEFAULT 0, "
+                      "moves BLOB);";
 
-    char* errMsg = nullptr;
-    rc = sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << errMsg << std::endl;
-        sqlite3_free(errMsg);
+    for (const std::string& statement : {pragmas, std::string(sql)}) {
+        char* errMsg = nullptr;
+        int rc = sqlite3_exec(db, statement.c_str(), nullptr, nullptr, &errMsg);
+        if (rc != SQLITE_OK) {
+            std::cerr << "SQL error: " << errMsg << std::endl;
+            sqlite3_free(errMsg);
+        }
+    }
+
+    statements.attach(db);
+    upgrade_schema();
+    for (const char* statement : {BEGIN_SQL, COMMIT_SQL, ROLLBACK_SQL, UPSERT_PLAYER_SQL, INSERT_GAME_SQL}) {
+        statements.get(statement);
     }
 }
 
 /**
- * @brief Updates or inserts a player's ELO rating in the database.
+ * @brief Adds the columns that databases created by older versions lack.
+ */
+void DatabaseManager::upgrade_schema() {
+    const char* const columns[][3] = {
+        {"players", "games", "INTEGER NOT NULL DEFAULT 0"},
+        {"players", "last_seen", "INTEGER NOT NULL DEFAULT 0"},
+        {"players", "rd", "REAL NOT NULL DEFAULT 350"},
+        {"players", "volatility", "REAL NOT NULL DEFAULT 0.06"},
+        {"games", "started_at", "INTEGER NOT NULL DEFAULT 0"},
+        {"games", "rows", "INTEGER NOT NULL DEFAULT 0"},
+        {"games", "columns", "INTEGER NOT NULL DEFAULT 0"},
+        {"games", "win_condition", "INTEGER NOT NULL DEFAULT 0"},
+        {"games", "move_count", "INTEGER NOT NULL DEFAULT 0"},
+        {"games", "moves", "BLOB"},
+    };
+    for (const auto& [table, column, definition] : columns) {
+        bool exists = false;
+        {
+            StatementCache::Statement stmt = statements.get(COLUMN_EXISTS_SQL);
+            if (stmt.get()) {
+                sqlite3_bind_text(stmt.get(), 1, table, -1, SQLITE_STATIC);
+                sqlite3_bind_text(stmt.get(), 2, column, -1, SQLITE_STATIC);
+                exists = sqlite3_step(stmt.get()) == SQLITE_ROW;
+            }
+        }
+        if (exists) {
+            continue;
+        }
+
+        std::string sql = std::string("ALTER TABLE ") + table + " ADD COLUMN " + column + " " + definition + ";";
+        char* errMsg = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+            std::cerr << "SQL error: " << errMsg << std::endl;
+            sqlite3_free(errMsg);
+        }
+    }
+}
+
+/**
+ * @brief Opens a connection and applies the per-connection settings.
+ * @param flags The sqlite3_open_v2 flags.
+ * @return The connection, or nullptr if it could not be opened.
+ */
+sqlite3* DatabaseManager::open_connection(int flags) {
+    sqlite3* connection = nullptr;
+    if (sqlite3_open_v2(config.path.c_str(), &connection, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open database: " << sqlite3_errmsg(connection) << std::endl;
+        sqlite3_close(connection);
+        return nullptr;
+    }
+
+    // WAL readers never wait for the writer, but checkpoints and a rollback journal still can.
+    sqlite3_busy_timeout(connection, 5000);
+    std::string pragmas = "PRAGMA cache_size = -" + std::to_string(config.cache_size_kb) + ";"
+                          "PRAGMA mmap_size = " + std::to_string(static_cast<int64_t>(config.mmap_size_mb) << 20) + ";";
+    sqlite3_exec(connection, pragmas.c_str(), nullptr, nullptr, nullptr);
+    return connection;
+}
+
+/**
+ * @brief Queues an update or insert of a player's ELO rating, to be committed by the writer thread.
  * @param name The name of the player.
  * @param elo_change The change in the player's ELO rating.
  */
 void DatabaseManager::update_or_insert_player_elo(const std::string& name, int elo_change) {
-    const char* sql = "INSERT INTO players (name, elo) VALUES (?, 100 + ?) "
-                      "ON CONFLICT(name) DO UPDATE SET elo = elo + ?;";
+    if (config.read_only) {
+        std::cerr << "Dropped rating update of " << name << ": the database is open read-only." << std::endl;
+        return;
+    }
 
-    sqlite3_stmt* stmt;
-    sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 2, elo_change);
-    sqlite3_bind_int(stmt, 3, elo_change);
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    progress_cv.wait(lock, [this] { return queue.size() + game_queue.size() < static_cast<size_t>(config.queue_capacity) || stopping; });
 
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-        std::cerr << "Failed to update ELO: " << sqlite3_errmsg(db) << std::endl;
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    queue.push_back({name, elo_change, now});
+    pending[name].add(queue.back());
+    cache.apply(name, elo_change, now);
+    ++queued_count;
+    if (queue.size() + game_queue.size() >= static_cast<size_t>(config.batch_size)) {
+        writer_cv.notify_one();
     }
+}
 
+/**
+ * @brief Queues a finished game, to be added to the games table by the writer thread.
+ * @param game The game. An end time of 0 is replaced by the current time.
+ */
+void DatabaseManager::record_game(GameRecord game) {
+    if (game.played_at == 0) {
+        game.played_at = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    if (config.read_only) {
+        std::cerr << "Dropped game of " << game.player << ": the database is open read-only." << std::endl;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    progress_cv.wait(lock, [this] { return queue.size() + game_queue.size() < static_cast<size_t>(config.queue_capacity) || stopping; });
+
+    game_queue.push_back(std::move(game));
+    ++queued_count;
+    if (queue.size() + game_queue.size() >= static_cast<size_t>(config.batch_size)) {
+        writer_cv.notify_one();
+    }
+}
+
+/**
+ * @brief Reads one committed game.
+ * @param id The id of the game, its row in the games table.
+ * @param game Receives the game.
+ * @return True if the game exists, false otherwise.
+ */
+bool DatabaseManager::load_game(int64_t id, GameRecord& game) {
+    if (readers.empty()) {
+        return false;
+    }
+
+    ReadConnection& reader = *readers[next_reader++ % readers.size()];
+    std::lock_guard<std::mutex> lock(reader.mutex);
+    StatementCache::Statement stmt = reader.statements.get(SELECT_GAME_SQL);
+    if (!stmt.get()) {
+        return false;
+    }
+    sqlite3_bind_int64(stmt.get(), 1, id);
+    if (sqlite3_step(stmt.get()) != SQLITE_ROW) {
+        return false;
+    }
+
+    game.player = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 0));
+    game.opponent = reinterpret_cast<const char*>(sqlite3_column_text(stmt.get(), 1));
+    game.score = sqlite3_column_double(stmt.get(), 2);
+    game.played_at = sqlite3_column_int64(stmt.get(), 3);
+    game.started_at = sqlite3_column_int64(stmt.get(), 4);
+    game.rows = sqlite3_column_int(stmt.get(), 5);
+    game.columns = sqlite3_column_int(stmt.get(), 6);
+    game.win_condition = sqlite3_column_int(stmt.get(), 7);
+    game.move_count = sqlite3_column_int(stmt.get(), 8);
+    const uint8_t* moves = static_cast<const uint8_t*>(sqlite3_column_blob(stmt.get(), 9));
+    game.moves.assign(moves, moves + sqlite3_column_bytes(stmt.get(), 9));
+    return true;
+}
+
+/**
+ * @brief Reads every committed game in the order they were recorded.
+ * @param visit Called with the player, the opponent, the player's score and the Unix time of each game.
+ */
+void DatabaseManager::for_each_game(const std::function<void(const char*, const char*, double, int64_t)>& visit) {
+    // A connection of its own, so the long read does not hold up rating lookups.
+    sqlite3* connection = open_connection(SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+    if (!connection) {
+        return;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(connection, "SELECT player, opponent, score, played_at FROM games ORDER BY id;", -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            visit(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                  reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
+                  sqlite3_column_double(stmt, 2), sqlite3_column_int64(stmt, 3));
+        }
+    } else {
+        std::cerr << "Failed to read games: " << sqlite3_errmsg(connection) << std::endl;
+    }
     sqlite3_finalize(stmt);
+    sqlite3_close(connection);
 }
 
 /**
- * @brief Retrieves a player's ELO rating from the database.
+ * @brief Replaces the ratings of players, as a batch recomputation does.
+ * @param records The players and their new rating, deviation and volatility.
+ */
+void DatabaseManager::store_ratings(const std::vector<std::pair<std::string, PlayerRecord>>& records) {
+    std::lock_guard<std::mutex> lock(write_mutex);
+    if (!statements.get(BEGIN_SQL).execute()) {
+        std::cerr << "Failed to begin storing ratings: " << (db ? sqlite3_errmsg(db) : "no connection") << std::endl;
+        return;
+    }
+
+    for (const auto& [name, record] : records) {
+        StatementCache::Statement stmt = statements.get(STORE_RATING_SQL);
+        sqlite3_bind_text(stmt.get(), 1, name.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt.get(), 2, record.elo);
+        sqlite3_bind_double(stmt.get(), 3, record.deviation);
+        sqlite3_bind_double(stmt.get(), 4, record.volatility);
+        if (!stmt.execute()) {
+            std::cerr << "Failed to store rating: " << sqlite3_errmsg(db) << std::endl;
+        }
+    }
+
+    // Every cached rating may be stale now.
+    commit([this] { cache.clear(); });
+}
+
+/**
+ * @brief Retrieves a player's ELO rating from the database, including queued updates.
  * @param name The name of the player.
- * @return The player's ELO rating.
+ * @return The player's ELO rating, or -1 if the player has no recorded games.
  */
 int DatabaseManager::get_player_elo(const std::string& name) {
-    const char* sql = "SELECT elo FROM players WHERE name = ?;";
-    sqlite3_stmt* stmt;
-    int elo = -1;
+    PlayerRecord record = get_player(name);
+    return record.known ? record.elo : -1;
+}
+
+/**
+ * @brief Retrieves a player's record from the cache or the database, including queued updates.
+ * @param name The name of the player.
+ * @return The player's record.
+ */
+PlayerRecord DatabaseManager::get_player(const std::string& name) {
+    PlayerRecord record;
+    if (cache.find(name, record)) {
+        return record;
+    }
+
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    while (true) {
+        // A commit that overlapped the read may or may not be in it, and its updates may
+        // or may not still be pending, so only a read between two commits is used. A commit
+        // in progress is waited out rather than raced with further queries.
+        progress_cv.wait(lock, [this] { return commit_sequence % 2 == 0; });
+        uint64_t sequence = commit_sequence;
+        lock.unlock();
+
+        record = read_player(name);
+
+        lock.lock();
+        if (sequence != commit_sequence) {
+            continue;
+        }
+        auto it = pending.find(name);
+        if (it != pending.end()) {
+            record.known = true;
+            record.elo += it->second.elo_change;
+            record.games += it->second.games;
+            record.last_seen = std::max(record.last_seen, it->second.last_seen);
+        }
+
+        // Updates are applied to the cache under the same lock, so none can slip in between.
+        cache.insert(name, record);
+        return record;
+    }
+}
+
+/**
+ * @brief Gets the in-memory cache of player records.
+ * @return The cache.
+ */
+const PlayerCache& DatabaseManager::player_cache() const {
+    return cache;
+}
+
+/**
+ * @brief Reads a player's committed record.
+ * @param name The name of the player.
+ * @return The record, not known if the player has no row.
+ */
+PlayerRecord DatabaseManager::read_player(const std::string& name) {
+    PlayerRecord record;
+    if (readers.empty()) {
+        return record;
+    }
+
+    ReadConnection& reader = *readers[next_reader++ % readers.size()];
+    std::lock_guard<std::mutex> lock(reader.mutex);
+    StatementCache::Statement stmt = reader.statements.get(SELECT_PLAYER_SQL);
+    if (stmt.get()) {
+        sqlite3_bind_text(stmt.get(), 1, name.c_str(), -1, SQLITE_STATIC);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+            record.known = true;
+            record.elo = sqlite3_column_int(stmt.get(), 0);
+            record.games = sqlite3_column_int(stmt.get(), 1);
+            record.last_seen = sqlite3_column_int64(stmt.get(), 2);
+            record.deviation = sqlite3_column_double(stmt.get(), 3);
+            record.volatility = sqlite3_column_double(stmt.get(), 4);
+        }
+    }
+    return record;
+}
 
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            elo = sqlite3_column_int(stmt, 0);
+/**
+ * @brief Waits until every rating update queued so far is committed.
+ */
+void DatabaseManager::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    uint64_t target = queued_count;
+    flush_requested = true;
+    writer_cv.notify_one();
+    progress_cv.wait(lock, [this, target] { return written_count >= target; });
+}
+
+/**
+ * @brief Commits queued rating updates until the manager is destroyed. Runs on the writer thread.
+ */
+void DatabaseManager::run_writer() {
+    std::vector<EloUpdate> batch;
+    std::vector<GameRecord> games;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            writer_cv.wait_for(lock, flush_interval, [this] {
+                return stopping || flush_requested || queue.size() + game_queue.size() >= static_cast<size_t>(config.batch_size);
+            });
+            // A flush of an empty queue has nothing to wait for, and left set it would keep the wait from sleeping.
+            flush_requested = false;
+            if (queue.empty() && game_queue.empty()) {
+                if (stopping) {
+                    break;
+                }
+                continue;
+            }
+            batch.assign(std::make_move_iterator(queue.begin()), std::make_move_iterator(queue.end()));
+            queue.clear();
+            games.assign(std::make_move_iterator(game_queue.begin()), std::make_move_iterator(game_queue.end()));
+            game_queue.clear();
+        }
+        progress_cv.notify_all();
+
+        write_batch(batch, games);
+        batch.clear();
+        games.clear();
+    }
+}
+
+/**
+ * @brief Writes a batch of rating updates and game results in one transaction.
+ * @param batch The updates to write.
+ * @param games The game results to write.
+ */
+void DatabaseManager::write_batch(const std::vector<EloUpdate>& batch, const std::vector<GameRecord>& games) {
+    // Several games of one player in a batch only need one row update.
+    std::map<std::string, PlayerChange> changes;
+    for (const EloUpdate& update : batch) {
+        changes[update.name].add(update);
+    }
+
+    std::lock_guard<std::mutex> lock(write_mutex);
+    if (statements.get(BEGIN_SQL).execute()) {
+        for (const auto& [name, change] : changes) {
+            StatementCache::Statement stmt = statements.get(UPSERT_PLAYER_SQL);
+            sqlite3_bind_text(stmt.get(), 1, name.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt.get(), 2, change.elo_change);
+            sqlite3_bind_int(stmt.get(), 3, change.games);
+            sqlite3_bind_int64(stmt.get(), 4, change.last_seen);
+            if (!stmt.execute()) {
+                std::cerr << "Failed to update ELO: " << sqlite3_errmsg(db) << std::endl;
+            }
+        }
+        for (const GameRecord& game : games) {
+            StatementCache::Statement stmt = statements.get(INSERT_GAME_SQL);
+            sqlite3_bind_text(stmt.get(), 1, game.player.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt.get(), 2, game.opponent.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_double(stmt.get(), 3, game.score);
+            sqlite3_bind_int64(stmt.get(), 4, game.played_at);
+            sqlite3_bind_int64(stmt.get(), 5, game.started_at);
+            sqlite3_bind_int(stmt.get(), 6, game.rows);
+            sqlite3_bind_int(stmt.get(), 7, game.columns);
+            sqlite3_bind_int(stmt.get(), 8, game.win_condition);
+            sqlite3_bind_int(stmt.get(), 9, game.move_count);
+            sqlite3_bind_blob(stmt.get(), 10, game.moves.data(), static_cast<int>(game.moves.size()), SQLITE_STATIC);
+            if (!stmt.execute()) {
+                std::cerr << "Failed to record game: " << sqlite3_errmsg(db) << std::endl;
+            }
         }
     } else {
-        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << std::endl;
+        std::cerr << "Failed to begin ELO updates: " << (db ? sqlite3_errmsg(db) : "no connection") << std::endl;
     }
 
-    sqlite3_finalize(stmt);
-    return elo;
-} 
\ No newline at end of file
+    commit([&] {
+        for (const auto& [name, change] : changes) {
+            auto it = pending.find(name);
+            if (it == pending.end()) {
+                continue;
+            }
+            it->second.elo_change -= change.elo_change;
+            it->second.games -= change.games;
+            if (it->second.games == 0) {
+                pending.erase(it);
+            }
+        }
+        written_count += batch.size() + games.size();
+    });
+}
+
+/**
+ * @brief Commits the open transaction of db and publishes it to readers.
+ * @param published Called before readers may use the commit, to adjust the pending changes and the cache.
+ */
+void DatabaseManager::commit(const std::function<void()>& published) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        ++commit_sequence;
+    }
+    if (db && sqlite3_get_autocommit(db) == 0 && !statements.get(COMMIT_SQL).execute()) {
+        std::cerr << "Failed to commit: " << sqlite3_errmsg(db) << std::endl;
+        statements.get(ROLLBACK_SQL).execute();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        published();
+        ++commit_sequence;
+    }
+    progress_cv.notify_all();
+}
+
+/**
+ * @brief Adds an update to the change.
+ * @param update The update.
+ */
+void DatabaseManager::PlayerChange::add(const EloUpdate& update) {
+    elo_change += update.elo_change;
+    games++;
+    last_seen = std::max(last_seen, update.last_seen);
+}
@@ -1,49 +1,242 @@
 #ifndef DATABASEMANAGER_H
 #define DATABASEMANAGER_H
 
+#include "GameRecord.h"
+#include "PlayerCache.h"
+#include "StatementCache.h"
 #include <string>
 #include <sqlite3.h>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * @struct DatabaseConfig
+ * @brief Settings of the database connections and of the rating writer.
+ */
+struct DatabaseConfig {
+    std::string path = "connect_four.db"; /**< The path of the database file. */
+    std::string journal_mode = "WAL"; /**< The SQLite journal mode. */
+    std::string synchronous = "NORMAL"; /**< The SQLite synchronous setting of the writer connection. */
+    int cache_size_kb = 8192; /**< The page cache size of each connection in kilobytes. */
+    int mmap_size_mb = 256; /**< The number of megabytes of the file each connection reads through a memory mapping. */
+    int read_connections = 4; /**< The number of read-only connections serving rating lookups. */
+    int batch_size = 64; /**< The number of queued rating updates that triggers a commit. */
+    int flush_interval_ms = 100; /**< The longest time in milliseconds between two commits of queued updates. */
+    int queue_capacity = 4096; /**< The number of queued updates and games at which queuing more starts blocking. */
+    int player_cache_size = 100000; /**< The largest number of player records kept in memory, 0 to disable the cache. */
+    bool read_only = false; /**< Whether to only open existing databases for reading, without the writer connection and thread. */
+};
 
 /**
  * @class DatabaseManager
  * @brief A class responsible for managing database operations.
+ *
+ * Rating updates and game results are write-behind: callers only queue them, and a writer thread with
+ * its own connection commits them in batched transactions. Lookups go through a small
+ * pool of read-only connections, which in WAL mode never wait for the writer. Reads
+ * add the updates that are not committed yet, so a player's rating is always up to date.
+ *
+ * Player records are cached in memory and every update is applied to the cached record
+ * as it is queued, so lookups of returning players do not touch the database.
+ *
+ * Every connection prepares each of its statements once and reuses them.
+ *
+ * A read-only manager only opens the read connections of an existing database, and
+ * drops any update queued on it.
  */
 class DatabaseManager {
 public:
     /**
-     * @brief Constructor for the DatabaseManager class. Initializes the database connection.
+     * @brief Constructor for the DatabaseManager class. Initializes the database connections and starts the rating writer.
+     * @param config The database settings.
      */
-    DatabaseManager();
+    explicit DatabaseManager(const DatabaseConfig& config = DatabaseConfig());
 
     /**
-     * @brief Destructor for the DatabaseManager class. Closes the database connection.
+     * @brief Destructor for the DatabaseManager class. Commits the queued rating updates and closes the database connections.
      */
     ~DatabaseManager();
 
     /**
-     * @brief Initializes the database, creating necessary tables if they do not exist.
+     * @brief Initializes the database, creating necessary tables if they do not exist, and opens the read connections.
      */
     void init_database();
 
     /**
-     * @brief Updates or inserts a player's ELO rating in the database.
+     * @brief Checks whether the database could be opened.
+     * @return True if lookups can reach the database, false otherwise.
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Queues an update or insert of a player's ELO rating, to be committed by the writer thread.
      * @param name The name of the player.
      * @param elo_change The change in the player's ELO rating.
      */
     void update_or_insert_player_elo(const std::string& name, int elo_change);
 
     /**
-     * @brief Retrieves a player's ELO rating from the database.
+     * @brief Queues a finished game, to be added to the games table by the writer thread.
+     * @param game The game. An end time of 0 is replaced by the current time.
+     */
+    void record_game(GameRecord game);
+
+    /**
+     * @brief Reads one committed game.
+     * @param id The id of the game, its row in the games table.
+     * @param game Receives the game.
+     * @return True if the game exists, false otherwise.
+     */
+    bool load_game(int64_t id, GameRecord& game);
+
+    /**
+     * @brief Reads every committed game in the order they were recorded.
+     * @param visit Called with the player, the opponent, the player's score and the Unix time of each game.
+     */
+    void for_each_game(const std::function<void(const char*, const char*, double, int64_t)>& visit);
+
+    /**
+     * @brief Replaces the ratings of players, as a batch recomputation does.
+     * @param records The players and their new rating, deviation and volatility.
+     */
+    void store_ratings(const std::vector<std::pair<std::string, PlayerRecord>>& records);
+
+    /**
+     * @brief Retrieves a player's ELO rating from the database, including queued updates.
      * @param name The name of the player.
-     * @return The player's ELO rating.
+     * @return The player's ELO rating, or -1 if the player has no recorded games.
      */
     int get_player_elo(const std::string& name);
 
+    /**
+     * @brief Retrieves a player's record from the cache or the database, including queued updates.
+     * @param name The name of the player.
+     * @return The player's record.
+     */
+    PlayerRecord get_player(const std::string& name);
+
+    /**
+     * @brief Gets the in-memory cache of player records.
+     * @return The cache.
+     */
+    const PlayerCache& player_cache() const;
+
+    /**
+     * @brief Waits until every rating update queued so far is committed.
+     */
+    void flush();
+
 private:
-    sqlite3* db; /**< Pointer to the SQLite database. */
-    std::string database_name; /**< The name of the database. */
+    /**
+     * @struct EloUpdate
+     * @brief A queued change of a player's rating.
+     */
+    struct EloUpdate {
+        std::string name; /**< The name of the player. */
+        int elo_change; /**< The change in the player's ELO rating. */
+        int64_t last_seen; /**< The Unix time of the game. */
+    };
+
+    /**
+     * @struct PlayerChange
+     * @brief The combined change of several updates of one player.
+     */
+    struct PlayerChange {
+        int elo_change = 0; /**< The change in the player's ELO rating. */
+        int games = 0; /**< The number of combined updates. */
+        int64_t last_seen = 0; /**< The Unix time of the latest game. */
+
+        /**
+         * @brief Adds an update to the change.
+         * @param update The update.
+         */
+        void add(const EloUpdate& update);
+    };
+
+    /**
+     * @struct ReadConnection
+     * @brief A read-only connection and its statements, used by one thread at a time.
+     */
+    struct ReadConnection {
+        std::mutex mutex; /**< Lets one thread at a time use the connection. */
+        sqlite3* db = nullptr; /**< The read-only connection. */
+        StatementCache statements; /**< The prepared statements of the connection. */
+    };
+
+    /**
+     * @brief Reads a player's committed record.
+     * @param name The name of the player.
+     * @return The record, not known if the player has no row.
+     */
+    PlayerRecord read_player(const std::string& name);
+
+    /**
+     * @brief Opens the read-write connection, creating the database and its tables if they do not exist.
+     */
+    void init_writer_connection();
+
+    /**
+     * @brief Adds the columns that databases created by older versions lack.
+     */
+    void upgrade_schema();
+
+    /**
+     * @brief Opens a connection and applies the per-connection settings.
+     * @param flags The sqlite3_open_v2 flags.
+     * @return The connection, or nullptr if it could not be opened.
+     */
+    sqlite3* open_connection(int flags);
+
+    /**
+     * @brief Commits queued rating updates until the manager is destroyed. Runs on the writer thread.
+     */
+    void run_writer();
+
+    /**
+     * @brief Writes a batch of rating updates and game results in one transaction.
+     * @param batch The updates to write.
+     * @param games The game results to write.
+     */
+    void write_batch(const std::vector<EloUpdate>& batch, const std::vector<GameRecord>& games);
+
+    /**
+     * @brief Commits the open transaction of db and publishes it to readers.
+     * @param published Called before readers may use the commit, to adjust the pending changes and the cache.
+     */
+    void commit(const std::function<void()>& published);
+
+    DatabaseConfig config; /**< The database settings. */
+    sqlite3* db; /**< The read-write connection, used under write_mutex once the writer runs. */
+    StatementCache statements; /**< The prepared statements of db. */
+    std::vector<std::unique_ptr<ReadConnection>> readers; /**< The read-only connections. */
+    std::atomic<size_t> next_reader{0}; /**< Spreads lookups over the read connections. */
+
+    std::chrono::milliseconds flush_interval; /**< The longest time between two commits. */
+    std::deque<EloUpdate> queue; /**< The updates waiting for the writer. */
+    std::deque<GameRecord> game_queue; /**< The finished games waiting for the writer. */
+    std::unordered_map<std::string, PlayerChange> pending; /**< The total uncommitted change per player. */
+    PlayerCache cache; /**< The records of recently seen players. */
+    uint64_t queued_count = 0; /**< The number of updates and games ever queued. */
+    uint64_t written_count = 0; /**< The number of updates and games the writer has finished with. */
+    uint64_t commit_sequence = 0; /**< Odd while a commit is in progress, bumped before and after each one. */
+    bool flush_requested = false; /**< Whether a caller is waiting for the queue to be committed. */
+    bool stopping = false; /**< Whether the writer must drain the queue and exit. */
+    std::mutex queue_mutex; /**< Guards the queues, the pending changes and the counters. */
+    std::mutex write_mutex; /**< Lets one writer at a time use db. */
+    std::condition_variable writer_cv; /**< Wakes the writer. */
+    std::condition_variable progress_cv; /**< Wakes producers waiting for room, callers of flush and lookups waiting out a commit. */
+    std::thread writer; /**< The thread committing rating updates. */
 };
 
-#endif // DATABASEMANAGER_H 
\ No newline at end of file
+#endif // DATABASEMANAGER_H
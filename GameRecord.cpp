@@ -0,0 +1,55 @@
+#include "GameRecord.h"
+#include <algorithm>
+#include <bit>
+
+/**
+ * @brief Gets the number of bits a move takes on a board.
+ * @param columns The number of columns on the board.
+ * @return 3 for up to 8 columns, 4 for up to 16.
+ */
+int GameRecord::bits_per_move(int columns) {
+    return std::max(3, static_cast<int>(std::bit_width(static_cast<unsigned>(std::max(columns, 1) - 1))));
+}
+
+/**
+ * @brief Packs a sequence of moves, least significant bits first.
+ * @param history The columns played, in order.
+ * @param columns The number of columns on the board.
+ * @return The packed moves.
+ */
+std::vector<uint8_t> GameRecord::pack_moves(std::span<const uint8_t> history, int columns) {
+    int bits = bits_per_move(columns);
+    std::vector<uint8_t> packed((history.size() * bits + 7) / 8, 0);
+    size_t position = 0;
+    for (uint8_t column : history) {
+        // A move spans at most two bytes.
+        unsigned value = static_cast<unsigned>(column) << (position % 8);
+        packed[position / 8] |= static_cast<uint8_t>(value);
+        if (value > 0xFF) {
+            packed[position / 8 + 1] |= static_cast<uint8_t>(value >> 8);
+        }
+        position += bits;
+    }
+    return packed;
+}
+
+/**
+ * @brief Unpacks the moves of the record.
+ * @return The columns played, in order.
+ */
+std::vector<uint8_t> GameRecord::unpack_moves() const {
+    int bits = bits_per_move(columns);
+    unsigned mask = (1u << bits) - 1;
+    std::vector<uint8_t> history;
+    history.reserve(move_count);
+    size_t position = 0;
+    for (int i = 0; i < move_count && (position + bits + 7) / 8 <= moves.size(); ++i) {
+        unsigned value = moves[position / 8];
+        if (position / 8 + 1 < moves.size()) {
+            value |= static_cast<unsigned>(moves[position / 8 + 1]) << 8;
+        }
+        history.push_back(static_cast<uint8_t>((value >> (position % 8)) & mask));
+        position += bits;
+    }
+    return history;
+}
@@ -0,0 +1,50 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @struct GameRecord
+ * @brief A finished game as archived in the games table.
+ *
+ * The moves alternate between the players, starting with the opponent, and are packed
+ * by pack_moves at the fewest bits that fit a column index of the board.
+ */
+struct GameRecord {
+    std::string player; /**< The name of the player. */
+    std::string opponent; /**< The name of the opponent. */
+    double score = 0; /**< The player's score: 1 for a win, 0.5 for a draw, 0 for a loss. */
+    int64_t started_at = 0; /**< The Unix time the game started. */
+    int64_t played_at = 0; /**< The Unix time the game ended. */
+    int rows = 0; /**< The number of rows on the board. */
+    int columns = 0; /**< The number of columns on the board. */
+    int win_condition = 0; /**< The number of discs in a row needed to win. */
+    int move_count = 0; /**< The number of moves. */
+    std::vector<uint8_t> moves; /**< The packed moves. */
+
+    /**
+     * @brief Gets the number of bits a move takes on a board.
+     * @param columns The number of columns on the board.
+     * @return 3 for up to 8 columns, 4 for up to 16.
+     */
+    static int bits_per_move(int columns);
+
+    /**
+     * @brief Packs a sequence of moves, least significant bits first.
+     * @param history The columns played, in order.
+     * @param columns The number of columns on the board.
+     * @return The packed moves.
+     */
+    static std::vector<uint8_t> pack_moves(std::span<const uint8_t> history, int columns);
+
+    /**
+     * @brief Unpacks the moves of the record.
+     * @return The columns played, in order.
+     */
+    std::vector<uint8_t> unpack_moves() const;
+};
+
+#endif // GAMERECORD_H
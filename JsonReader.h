@@ -0,0 +1,207 @@
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <json/json.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Parses a JSON document in place, without copying it into a stream.
+ *
+ * The reader is created once per thread and reused for every message.
+ * @param text The document.
+ * @param root Receives the parsed value.
+ * @param errors Receives the parse errors, may be nullptr.
+ * @return True if the document was parsed, false otherwise.
+ */
+inline bool parse_json(std::string_view text, Json::Value& root, std::string* errors) {
+    thread_local std::unique_ptr<Json::CharReader> reader = []() {
+        Json::CharReaderBuilder builder;
+        builder["collectComments"] = false;
+        return std::unique_ptr<Json::CharReader>(builder.newCharReader());
+    }();
+    return reader->parse(text.data(), text.data() + text.size(), &root, errors);
+}
+
+/**
+ * @class MoveMessageScanner
+ * @brief Recognizes the move message, {"type":"move","column":3}, without building a Json::Value.
+ *
+ * Only the exact shape is accepted: an object with the members "type" and "column" in any
+ * order, the type being "move" and the column an integer or a string of digits, with any
+ * whitespace between tokens. Anything else, escape sequences, control characters and numbers
+ * with leading zeros included, is left to the full parser, so the scanner never accepts a
+ * message the full parser would read differently.
+ */
+class MoveMessageScanner {
+public:
+    /**
+     * @brief Constructor for the MoveMessageScanner class.
+     * @param text The message.
+     */
+    explicit MoveMessageScanner(std::string_view text) : text(text) {}
+
+    /**
+     * @brief Scans the message.
+     * @param column Receives the column if the message is a move message.
+     * @return True if the message is a move message, false if it needs the full parser.
+     */
+    bool scan(int& column) {
+        bool has_type = false;
+        bool has_column = false;
+        if (!consume('{')) {
+            return false;
+        }
+        do {
+            std::string_view key;
+            if (!read_string(key) || !consume(':')) {
+                return false;
+            }
+            if (key == "type" && !has_type) {
+                std::string_view type;
+                if (!read_string(type) || type != "move") {
+                    return false;
+                }
+                has_type = true;
+            } else if (key == "column" && !has_column) {
+                std::string_view digits;
+                if (peek() == '"' ? !read_string(digits) : !read_number(digits)) {
+                    return false;
+                }
+                if (!to_int(digits, column)) {
+                    return false;
+                }
+                has_column = true;
+            } else {
+                return false;
+            }
+        } while (consume(','));
+        if (!consume('}')) {
+            return false;
+        }
+        skip_whitespace();
+        return has_type && has_column && position == text.size();
+    }
+
+private:
+    /**
+     * @brief Skips spaces, tabs and line breaks.
+     */
+    void skip_whitespace() {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t' ||
+                                          text[position] == '\n' || text[position] == '\r')) {
+            ++position;
+        }
+    }
+
+    /**
+     * @brief Gets the next character after any whitespace.
+     * @return The character, or 0 at the end of the message.
+     */
+    char peek() {
+        skip_whitespace();
+        return position < text.size() ? text[position] : '\0';
+    }
+
+    /**
+     * @brief Consumes a character if it comes next, after any whitespace.
+     * @param expected The character.
+     * @return True if it was consumed, false otherwise.
+     */
+    bool consume(char expected) {
+        if (peek() != expected) {
+            return false;
+        }
+        ++position;
+        return true;
+    }
+
+    /**
+     * @brief Reads a string without escape sequences or control characters.
+     * @param value Receives the characters between the quotes.
+     * @return True if a string was read, false otherwise.
+     */
+    bool read_string(std::string_view& value) {
+        if (!consume('"')) {
+            return false;
+        }
+        size_t begin = position;
+        while (position < text.size() && text[position] != '"') {
+            if (text[position] == '\\' || static_cast<unsigned char>(text[position]) < 0x20) {
+                return false;
+            }
+            ++position;
+        }
+        if (position == text.size()) {
+            return false;
+        }
+        value = text.substr(begin, position++ - begin);
+        return true;
+    }
+
+    /**
+     * @brief Reads an integer literal without leading zeros.
+     * @param value Receives the literal.
+     * @return True if an integer was read, false otherwise.
+     */
+    bool read_number(std::string_view& value) {
+        skip_whitespace();
+        size_t begin = position;
+        if (position < text.size() && text[position] == '-') {
+            ++position;
+        }
+        size_t digits = position;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+            ++position;
+        }
+        if (position - digits > 1 && text[digits] == '0') {
+            return false;
+        }
+        value = text.substr(begin, position - begin);
+        // A fraction or an exponent is left to the full parser.
+        return position == text.size() || (text[position] != '.' && text[position] != 'e' && text[position] != 'E');
+    }
+
+    /**
+     * @brief Converts a short run of digits, optionally negative, to an int.
+     * @param digits The digits.
+     * @param value Receives the number.
+     * @return True if the digits form a number of at most 9 digits, false otherwise.
+     */
+    static bool to_int(std::string_view digits, int& value) {
+        bool negative = !digits.empty() && digits[0] == '-';
+        if (negative) {
+            digits.remove_prefix(1);
+        }
+        if (digits.empty() || digits.size() > 9) {
+            return false;
+        }
+        value = 0;
+        for (char digit : digits) {
+            if (digit < '0' || digit > '9') {
+                return false;
+            }
+            value = value * 10 + (digit - '0');
+        }
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+    std::string_view text; /**< The message. */
+    size_t position = 0; /**< The index of the next character to read. */
+};
+
+/**
+ * @brief Recognizes a move message without building a Json::Value.
+ * @param text The message.
+ * @param column Receives the column if the message is a move message.
+ * @return True if the message is a move message, false if it needs the full parser.
+ */
+inline bool parse_move_message(std::string_view text, int& column) {
+    return MoveMessageScanner(text).scan(column);
+}
+
+#endif // JSONREADER_H
@@ -0,0 +1,79 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <json/json.h>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+/**
+ * @class StringAppendBuffer
+ * @brief A stream buffer that appends everything written to it to a string.
+ *
+ * Unlike std::ostringstream, the string is reachable without copying it, and clearing it
+ * keeps its capacity for the next message.
+ */
+class StringAppendBuffer : public std::streambuf {
+public:
+    /**
+     * @brief Constructor for the StringAppendBuffer class.
+     * @param output The string written to.
+     */
+    explicit StringAppendBuffer(std::string& output) : output(output) {}
+
+protected:
+    /**
+     * @brief Appends one character.
+     * @param ch The character, or EOF.
+     * @return The character.
+     */
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            output.push_back(traits_type::to_char_type(ch));
+        }
+        return ch;
+    }
+
+    /**
+     * @brief Appends a run of characters.
+     * @param s The characters.
+     * @param count The number of characters.
+     * @return The number of characters appended.
+     */
+    std::streamsize xsputn(const char* s, std::streamsize count) override {
+        output.append(s, static_cast<size_t>(count));
+        return count;
+    }
+
+private:
+    std::string& output; /**< The string written to. */
+};
+
+/**
+ * @brief Serializes a JSON value without any whitespace.
+ *
+ * The writer, the stream and the output buffer are created once per thread and reused, so
+ * after the first few messages a call only pays for the serialization itself. The result is
+ * valid until the next call on the same thread.
+ * @param value The value to serialize.
+ * @return The serialized value.
+ */
+inline std::string_view write_compact_json(const Json::Value& value) {
+    thread_local std::unique_ptr<Json::StreamWriter> writer = []() {
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "";
+        builder["commentStyle"] = "None";
+        return std::unique_ptr<Json::StreamWriter>(builder.newStreamWriter());
+    }();
+    thread_local std::string buffer;
+    thread_local StringAppendBuffer stream_buffer(buffer);
+    thread_local std::ostream stream(&stream_buffer);
+
+    buffer.clear();
+    writer->write(value, &stream);
+    return buffer;
+}
+
+#endif // JSONWRITER_H
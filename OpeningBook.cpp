@@ -0,0 +1,147 @@
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static_assert(sizeof(OpeningBook::Header) == 24, "The book header must be 24 bytes.");
+
+/**
+ * @brief Constructor for the OpeningBook class. Creates a closed book.
+ */
+OpeningBook::OpeningBook() : entries(nullptr), count(0) {}
+
+/**
+ * @brief Maps a book file into memory.
+ * @param path The path of the book file.
+ * @param rows The number of rows the book must have been built for.
+ * @param columns The number of columns the book must have been built for.
+ * @param win_condition The win condition the book must have been built for.
+ * @return True if the book was opened, false if it is missing, malformed or built for another board.
+ */
+bool OpeningBook::open(const std::string& path, int rows, int columns, int win_condition) {
+    entries = nullptr;
+    count = 0;
+
+    try {
+        file = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+        region = boost::interprocess::mapped_region(file, boost::interprocess::read_only);
+    } catch (const boost::interprocess::interprocess_exception&) {
+        return false;
+    }
+
+    const Header* header = static_cast<const Header*>(region.get_address());
+    if (region.get_size() < sizeof(Header) || std::memcmp(header->magic, "C4BK", 4) != 0 || header->version != VERSION) {
+        std::cerr << "Ignoring opening book " << path << ": not a book file." << std::endl;
+        return false;
+    }
+    if (header->rows != rows || header->columns != columns || header->win_condition != win_condition) {
+        std::cerr << "Ignoring opening book " << path << ": built for another board." << std::endl;
+        return false;
+    }
+    if (region.get_size() < sizeof(Header) + header->entry_count * sizeof(uint64_t)) {
+        std::cerr << "Ignoring opening book " << path << ": file is truncated." << std::endl;
+        return false;
+    }
+
+    entries = reinterpret_cast<const uint64_t*>(header + 1);
+    count = header->entry_count;
+    return true;
+}
+
+/**
+ * @brief Checks if a book is open.
+ * @return True if lookups can find positions, false otherwise.
+ */
+bool OpeningBook::is_open() const {
+    return entries != nullptr;
+}
+
+/**
+ * @brief Gets the number of positions in the book.
+ * @return The entry count, 0 if no book is open.
+ */
+size_t OpeningBook::size() const {
+    return count;
+}
+
+/**
+ * @brief Looks up a position with an interpolation search over the sorted entries.
+ * @param key The canonical position hash.
+ * @param best_move Receives the best column of the canonical orientation on a hit.
+ * @param score Receives the score for the player to move on a hit.
+ * @return True if the position is in the book, false otherwise.
+ */
+bool OpeningBook::lookup(uint64_t key, int& best_move, int& score) const {
+    if (count == 0) {
+        return false;
+    }
+
+    uint64_t target = key & KEY_MASK;
+    size_t low = 0;
+    size_t high = count - 1;
+
+    // Zobrist hashes are uniformly distributed, so interpolating lands close to the
+    // entry; a few steps narrow the range, and a binary search finishes it off.
+    for (int step = 0; step < 4 && high - low > 16; ++step) {
+        uint64_t low_key = entries[low] & KEY_MASK;
+        uint64_t high_key = entries[high] & KEY_MASK;
+        if (target < low_key || target > high_key || low_key == high_key) {
+            break;
+        }
+        size_t guess = low + static_cast<size_t>(static_cast<double>(target - low_key) / static_cast<double>(high_key - low_key) * (high - low));
+        if ((entries[guess] & KEY_MASK) < target) {
+            low = guess + 1;
+        } else {
+            high = guess;
+        }
+    }
+
+    const uint64_t* found = std::lower_bound(entries + low, entries + high + 1, target);
+    if (found == entries + count || (*found & KEY_MASK) != target) {
+        return false;
+    }
+
+    best_move = static_cast<int>(*found & 0xF);
+    score = static_cast<int8_t>((*found >> 4) & 0xFF);
+    return true;
+}
+
+/**
+ * @brief Packs a solved position into a book entry.
+ * @param key The canonical position hash.
+ * @param best_move The best column of the canonical orientation.
+ * @param score The score for the player to move.
+ * @return The packed entry.
+ */
+uint64_t OpeningBook::pack(uint64_t key, int best_move, int score) {
+    return (key & KEY_MASK) | static_cast<uint64_t>(static_cast<uint8_t>(score)) << 4 | static_cast<uint64_t>(best_move & 0xF);
+}
+
+/**
+ * @brief Sorts entries and writes them to a book file.
+ * @param path The path of the book file.
+ * @param rows The number of rows on the board.
+ * @param columns The number of columns on the board.
+ * @param win_condition The number of discs in a row needed to win.
+ * @param plies The book depth.
+ * @param entries The packed entries, sorted in place.
+ * @return True if the file was written, false otherwise.
+ */
+bool OpeningBook::write(const std::string& path, int rows, int columns, int win_condition, int plies, std::vector<uint64_t>& entries) {
+    std::sort(entries.begin(), entries.end());
+
+    Header header{};
+    std::memcpy(header.magic, "C4BK", 4);
+    header.version = VERSION;
+    header.rows = static_cast<uint8_t>(rows);
+    header.columns = static_cast<uint8_t>(columns);
+    header.win_condition = static_cast<uint8_t>(win_condition);
+    header.plies = static_cast<uint8_t>(plies);
+    header.entry_count = entries.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(uint64_t)));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,106 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class OpeningBook
+ * @brief A read-only, memory-mapped table of solved opening positions.
+ *
+ * The file is a 24-byte little-endian header followed by 64-bit entries sorted in
+ * ascending order. Each entry keeps the top 52 bits of the canonical position hash,
+ * then the score as a signed byte and the best column of the canonical orientation
+ * in the low 4 bits, so a position and its mirror image share one entry. Opening the
+ * book only maps the file, and lookups search the mapped entries in place.
+ */
+class OpeningBook {
+public:
+    /**
+     * @struct Header
+     * @brief The file header, which identifies the format and the board the book was built for.
+     */
+    struct Header {
+        char magic[4];         /**< Always "C4BK" */
+        uint16_t version;      /**< The format version, currently 2 */
+        uint8_t rows;          /**< The number of rows on the board */
+        uint8_t columns;       /**< The number of columns on the board */
+        uint8_t win_condition; /**< The number of discs in a row needed to win */
+        uint8_t plies;         /**< The book depth: every position up to this many moves is included */
+        uint8_t reserved[6];   /**< Zero */
+        uint64_t entry_count;  /**< The number of entries following the header */
+    };
+
+    static constexpr uint16_t VERSION = 2; /**< The format version written and accepted. */
+
+    /**
+     * @brief Constructor for the OpeningBook class. Creates a closed book.
+     */
+    OpeningBook();
+
+    /**
+     * @brief Maps a book file into memory.
+     * @param path The path of the book file.
+     * @param rows The number of rows the book must have been built for.
+     * @param columns The number of columns the book must have been built for.
+     * @param win_condition The win condition the book must have been built for.
+     * @return True if the book was opened, false if it is missing, malformed or built for another board.
+     */
+    bool open(const std::string& path, int rows, int columns, int win_condition);
+
+    /**
+     * @brief Checks if a book is open.
+     * @return True if lookups can find positions, false otherwise.
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Gets the number of positions in the book.
+     * @return The entry count, 0 if no book is open.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Looks up a position with an interpolation search over the sorted entries.
+     * @param key The canonical position hash.
+     * @param best_move Receives the best column of the canonical orientation on a hit.
+     * @param score Receives the score for the player to move on a hit.
+     * @return True if the position is in the book, false otherwise.
+     */
+    bool lookup(uint64_t key, int& best_move, int& score) const;
+
+    /**
+     * @brief Packs a solved position into a book entry.
+     * @param key The canonical position hash.
+     * @param best_move The best column of the canonical orientation.
+     * @param score The score for the player to move.
+     * @return The packed entry.
+     */
+    static uint64_t pack(uint64_t key, int best_move, int score);
+
+    /**
+     * @brief Sorts entries and writes them to a book file.
+     * @param path The path of the book file.
+     * @param rows The number of rows on the board.
+     * @param columns The number of columns on the board.
+     * @param win_condition The number of discs in a row needed to win.
+     * @param plies The book depth.
+     * @param entries The packed entries, sorted in place.
+     * @return True if the file was written, false otherwise.
+     */
+    static bool write(const std::string& path, int rows, int columns, int win_condition, int plies, std::vector<uint64_t>& entries);
+
+private:
+    static constexpr uint64_t KEY_MASK = ~UINT64_C(0xFFF); /**< The bits of an entry that hold the key. */
+
+    boost::interprocess::file_mapping file; /**< The mapped book file. */
+    boost::interprocess::mapped_region region; /**< The mapping of the whole file. */
+    const uint64_t* entries; /**< The sorted entries inside the mapping. */
+    size_t count; /**< The number of entries. */
+};
+
+#endif // OPENINGBOOK_H
@@ -0,0 +1,93 @@
+#include "ParallelSolver.h"
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Constructor for the ParallelSolver class.
+ * @param threads The number of threads to search with, including the calling thread.
+ * @param max_depth The maximum number of plies to look ahead, or 0 to search until the end of the game.
+ * @param table The shared transposition table. Without one, helper threads cannot help.
+ */
+template <typename Game>
+ParallelSolver<Game>::ParallelSolver(int threads, int max_depth, TranspositionTable* table)
+    : threads(threads < 1 ? 1 : threads), max_depth(max_depth), table(table), nodes(0) {}
+
+/**
+ * @brief Computes the score of a position.
+ * @param game The position to solve.
+ * @param player The player to move.
+ * @return The score of the position for the player to move.
+ */
+template <typename Game>
+int ParallelSolver<Game>::solve(const Game& game, Player player) {
+    return run(game, player, [](Solver<Game>& solver, Game& position, Player to_move) {
+        return solver.solve(position, to_move);
+    });
+}
+
+/**
+ * @brief Finds a move that achieves the score of the position.
+ * @param game The position to play from.
+ * @param player The player to move.
+ * @return The column of the best move, or -1 if the board is full.
+ */
+template <typename Game>
+int ParallelSolver<Game>::best_move(const Game& game, Player player) {
+    return run(game, player, [](Solver<Game>& solver, Game& position, Player to_move) {
+        return solver.best_move(position, to_move);
+    });
+}
+
+/**
+ * @brief Gets the number of positions visited by all threads in the last search.
+ * @return The node count.
+ */
+template <typename Game>
+uint64_t ParallelSolver<Game>::node_count() const {
+    return nodes;
+}
+
+/**
+ * @brief Runs a search on the calling thread while helper threads fill the transposition table.
+ * @param game The position to search.
+ * @param player The player to move.
+ * @param search The main thread's search, called with its solver and its copy of the game.
+ * @return The result of the main thread's search.
+ */
+template <typename Game>
+template <typename Search>
+int ParallelSolver<Game>::run(const Game& game, Player player, Search search) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> helper_nodes{0};
+    std::vector<std::thread> helpers;
+
+    if (table) {
+        for (int i = 1; i < threads; ++i) {
+            helpers.emplace_back([this, &game, player, &stop, &helper_nodes, i]() {
+                Game position = game;
+                Solver<Game> helper(max_depth, table);
+                helper.set_stop_flag(&stop);
+                helper.rotate_column_order(i);
+                helper.solve(position, player);
+                helper_nodes += helper.node_count();
+            });
+        }
+    }
+
+    Game position = game;
+    Solver<Game> solver(max_depth, table);
+    int result = search(solver, position, player);
+
+    stop = true;
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    nodes = solver.node_count() + helper_nodes;
+    return result;
+}
+
+template class ParallelSolver<ConnectFourGame<6, 7, 4>>;
+template class ParallelSolver<ConnectFourGame<7, 8, 4>>;
+template class ParallelSolver<ConnectFourGame<8, 9, 4>>;
+template class ParallelSolver<ConnectFourGame<6, 9, 5>>;
@@ -0,0 +1,75 @@
+#ifndef PARALLELSOLVER_H
+#define PARALLELSOLVER_H
+
+#include "Solver.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class ParallelSolver
+ * @brief A Lazy-SMP search driver that runs several solvers on the same position.
+ *
+ * The main thread searches as a plain Solver would. Helper threads search the same
+ * position with rotated move orders and share the transposition table, so the main
+ * search finds much of its tree already scored. The helpers stop as soon as the main
+ * search finishes, and only the main thread's result is used.
+ *
+ * @tparam Game The ConnectFourGame variant to solve.
+ */
+template <typename Game>
+class ParallelSolver {
+public:
+    /**
+     * @brief Constructor for the ParallelSolver class.
+     * @param threads The number of threads to search with, including the calling thread.
+     * @param max_depth The maximum number of plies to look ahead, or 0 to search until the end of the game.
+     * @param table The shared transposition table. Without one, helper threads cannot help.
+     */
+    explicit ParallelSolver(int threads = 1, int max_depth = 0, TranspositionTable* table = nullptr);
+
+    /**
+     * @brief Computes the score of a position.
+     * @param game The position to solve.
+     * @param player The player to move.
+     * @return The score of the position for the player to move.
+     */
+    int solve(const Game& game, Player player);
+
+    /**
+     * @brief Finds a move that achieves the score of the position.
+     * @param game The position to play from.
+     * @param player The player to move.
+     * @return The column of the best move, or -1 if the board is full.
+     */
+    int best_move(const Game& game, Player player);
+
+    /**
+     * @brief Gets the number of positions visited by all threads in the last search.
+     * @return The node count.
+     */
+    uint64_t node_count() const;
+
+private:
+    /**
+     * @brief Runs a search on the calling thread while helper threads fill the transposition table.
+     * @param game The position to search.
+     * @param player The player to move.
+     * @param search The main thread's search, called with its solver and its copy of the game.
+     * @return The result of the main thread's search.
+     */
+    template <typename Search>
+    int run(const Game& game, Player player, Search search);
+
+    int threads; /**< The number of threads to search with. */
+    int max_depth; /**< The maximum number of plies to look ahead, 0 for no limit. */
+    TranspositionTable* table; /**< The shared transposition table, or nullptr. */
+    uint64_t nodes; /**< The number of positions visited in the last search. */
+};
+
+extern template class ParallelSolver<ConnectFourGame<6, 7, 4>>;
+extern template class ParallelSolver<ConnectFourGame<7, 8, 4>>;
+extern template class ParallelSolver<ConnectFourGame<8, 9, 4>>;
+extern template class ParallelSolver<ConnectFourGame<6, 9, 5>>;
+
+#endif // PARALLELSOLVER_H
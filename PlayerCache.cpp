@@ -0,0 +1,129 @@
+#include "PlayerCache.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * @brief Constructor for the PlayerCache class.
+ * @param capacity The largest number of cached players, 0 to disable the cache.
+ */
+PlayerCache::PlayerCache(size_t capacity)
+    : shard_capacity((capacity + SHARD_COUNT - 1) / SHARD_COUNT) {}
+
+/**
+ * @brief Gets a cached record and marks it as recently used.
+ * @param name The name of the player.
+ * @param record Receives the record if the player is cached.
+ * @return True on a hit, false on a miss.
+ */
+bool PlayerCache::find(const std::string& name, PlayerRecord& record) {
+    Shard& shard = shard_of(name);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(name);
+        if (it != shard.index.end()) {
+            shard.order.splice(shard.order.begin(), shard.order, it->second);
+            record = it->second->second;
+            hit_count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    miss_count.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+/**
+ * @brief Caches a record, evicting the least recently used one of its shard if the shard is full.
+ * @param name The name of the player.
+ * @param record The record.
+ */
+void PlayerCache::insert(const std::string& name, const PlayerRecord& record) {
+    if (shard_capacity == 0) {
+        return;
+    }
+
+    Shard& shard = shard_of(name);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(name);
+    if (it != shard.index.end()) {
+        it->second->second = record;
+        shard.order.splice(shard.order.begin(), shard.order, it->second);
+        return;
+    }
+
+    if (shard.order.size() >= shard_capacity) {
+        shard.index.erase(shard.order.back().first);
+        shard.order.pop_back();
+        --count;
+    }
+    shard.order.emplace_front(name, record);
+    shard.index.emplace(name, shard.order.begin());
+    ++count;
+}
+
+/**
+ * @brief Applies a recorded game to the player's record, if it is cached.
+ * @param name The name of the player.
+ * @param elo_change The change in the player's ELO rating.
+ * @param last_seen The Unix time of the game.
+ */
+void PlayerCache::apply(const std::string& name, int elo_change, int64_t last_seen) {
+    Shard& shard = shard_of(name);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(name);
+    if (it == shard.index.end()) {
+        return;
+    }
+
+    PlayerRecord& record = it->second->second;
+    record.known = true;
+    record.elo += elo_change;
+    record.games++;
+    record.last_seen = std::max(record.last_seen, last_seen);
+}
+
+/**
+ * @brief Removes every record, for when ratings changed behind the cache's back.
+ */
+void PlayerCache::clear() {
+    for (Shard& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count -= shard.order.size();
+        shard.index.clear();
+        shard.order.clear();
+    }
+}
+
+/**
+ * @brief Gets the number of lookups that found their player.
+ * @return The hit count.
+ */
+uint64_t PlayerCache::hits() const {
+    return hit_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of lookups that did not find their player.
+ * @return The miss count.
+ */
+uint64_t PlayerCache::misses() const {
+    return miss_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of cached players.
+ * @return The player count.
+ */
+size_t PlayerCache::size() const {
+    return count;
+}
+
+/**
+ * @brief Gets the shard a player belongs to.
+ * @param name The name of the player.
+ * @return The shard.
+ */
+PlayerCache::Shard& PlayerCache::shard_of(const std::string& name) {
+    // Mix the hash so all of its bits decide the shard, which is picked by the top ones.
+    uint64_t hash = std::hash<std::string>()(name) * UINT64_C(0x9E3779B97F4A7C15);
+    return shards[hash >> (64 - SHARD_BITS)];
+}
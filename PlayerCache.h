@@ -0,0 +1,117 @@
+#ifndef PLAYERCACHE_H
+#define PLAYERCACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @struct PlayerRecord
+ * @brief What is known about a player.
+ */
+struct PlayerRecord {
+    bool known = false; /**< Whether the player has ever had a game recorded. */
+    int elo = 100; /**< The player's ELO rating. */
+    int games = 0; /**< The number of recorded games. */
+    int64_t last_seen = 0; /**< The Unix time of the last recorded game, 0 if none. */
+    double deviation = 350; /**< The Glicko-2 rating deviation. */
+    double volatility = 0.06; /**< The Glicko-2 volatility. */
+};
+
+/**
+ * @class PlayerCache
+ * @brief A bounded in-memory table of player records, split into independently locked shards.
+ *
+ * Each shard keeps its records in least-recently-used order and evicts the oldest one
+ * when it is full. The cache holds no data of its own: the owner fills it after reading
+ * a record and applies every change to it, so a cached record is always current.
+ */
+class PlayerCache {
+public:
+    static constexpr int SHARD_BITS = 4; /**< The number of hash bits that select a shard. */
+    static constexpr size_t SHARD_COUNT = size_t(1) << SHARD_BITS; /**< The number of shards. */
+
+    /**
+     * @brief Constructor for the PlayerCache class.
+     * @param capacity The largest number of cached players, 0 to disable the cache.
+     */
+    explicit PlayerCache(size_t capacity);
+
+    /**
+     * @brief Gets a cached record and marks it as recently used.
+     * @param name The name of the player.
+     * @param record Receives the record if the player is cached.
+     * @return True on a hit, false on a miss.
+     */
+    bool find(const std::string& name, PlayerRecord& record);
+
+    /**
+     * @brief Caches a record, evicting the least recently used one of its shard if the shard is full.
+     * @param name The name of the player.
+     * @param record The record.
+     */
+    void insert(const std::string& name, const PlayerRecord& record);
+
+    /**
+     * @brief Applies a recorded game to the player's record, if it is cached.
+     * @param name The name of the player.
+     * @param elo_change The change in the player's ELO rating.
+     * @param last_seen The Unix time of the game.
+     */
+    void apply(const std::string& name, int elo_change, int64_t last_seen);
+
+    /**
+     * @brief Removes every record, for when ratings changed behind the cache's back.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of lookups that found their player.
+     * @return The hit count.
+     */
+    uint64_t hits() const;
+
+    /**
+     * @brief Gets the number of lookups that did not find their player.
+     * @return The miss count.
+     */
+    uint64_t misses() const;
+
+    /**
+     * @brief Gets the number of cached players.
+     * @return The player count.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @struct Shard
+     * @brief One lock and the records it guards, padded to its own cache line.
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex mutex; /**< Guards the records of this shard. */
+        std::list<std::pair<std::string, PlayerRecord>> order; /**< The records, most recently used first. */
+        std::unordered_map<std::string, std::list<std::pair<std::string, PlayerRecord>>::iterator> index; /**< The records by name. */
+    };
+
+    /**
+     * @brief Gets the shard a player belongs to.
+     * @param name The name of the player.
+     * @return The shard.
+     */
+    Shard& shard_of(const std::string& name);
+
+    size_t shard_capacity; /**< The largest number of records per shard. */
+    std::array<Shard, SHARD_COUNT> shards; /**< The shards. */
+    std::atomic<uint64_t> hit_count{0}; /**< The number of lookups that found their player. */
+    std::atomic<uint64_t> miss_count{0}; /**< The number of lookups that did not find their player. */
+    std::atomic<size_t> count{0}; /**< The number of records in all shards. */
+};
+
+#endif // PLAYERCACHE_H
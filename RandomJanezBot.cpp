@@ -17,14 +17,14 @@ RandomJanezBot::RandomJanezBot() {
 int RandomJanezBot::get_move() {
     // Prioritize the center column if the last move was valid
     if (last_result_valid) {
-        last_column = 3;
-        return 3;
+        last_column = columns / 2;
+        return last_column;
     }
 
     // If the last result was invalid or the center column is not an option, choose a random column
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 6);
+    std::uniform_int_distribution<> dis(0, columns - 1);
 
     int column;
     do {
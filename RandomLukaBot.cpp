@@ -16,7 +16,7 @@ RandomLukaBot::RandomLukaBot() {
 int RandomLukaBot::get_move() {
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 6);
+    std::uniform_int_distribution<> dis(0, columns - 1);
     int column = dis(gen);
     return column;
 }
@@ -0,0 +1,260 @@
+#include "RatingEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <thread>
+#include <unordered_map>
+
+static constexpr double GLICKO2_SCALE = 173.7178; /**< Converts between the rating and the Glicko-2 scale. */
+static constexpr double MAX_DEVIATION = 350; /**< The deviation of a new player, which inactivity never exceeds. */
+
+/**
+ * @brief Computes the Elo expected score of a player.
+ * @param rating The player's rating.
+ * @param opponent_rating The opponent's rating.
+ * @return The expected score, between 0 and 1.
+ */
+double elo_expected_score(double rating, double opponent_rating) {
+    return 1.0 / (1.0 + std::pow(10.0, (opponent_rating - rating) / 400.0));
+}
+
+/**
+ * @brief Computes the Elo rating change of a player after one game.
+ * @param rating The player's rating.
+ * @param opponent_rating The opponent's rating.
+ * @param score The player's score.
+ * @param k_factor The largest change.
+ * @return The rounded change; the opponent's change is its negation.
+ */
+int elo_change(int rating, int opponent_rating, double score, double k_factor) {
+    return static_cast<int>(std::lround(k_factor * (score - elo_expected_score(rating, opponent_rating))));
+}
+
+/**
+ * @brief Computes the Glicko-2 weight of an opponent's deviation.
+ * @param phi The opponent's deviation on the Glicko-2 scale.
+ * @return The weight.
+ */
+static double glicko2_g(double phi) {
+    return 1.0 / std::sqrt(1.0 + 3.0 * phi * phi / (std::numbers::pi * std::numbers::pi));
+}
+
+/**
+ * @brief Computes a player's Glicko-2 rating after a rating period in which they played.
+ * @param player The player's rating at the start of the period.
+ * @param results The player's games in the period.
+ * @param ratings The ratings of all players at the start of the period, indexed by player.
+ * @param tau The constraint on volatility changes.
+ * @return The rating at the end of the period.
+ */
+GlickoRating glicko2_update(const GlickoRating& player, std::span<const GlickoResult> results,
+                            const std::vector<GlickoRating>& ratings, double tau) {
+    // Step 2 onwards of Glickman's "Example of the Glicko-2 system".
+    double mu = player.rating / GLICKO2_SCALE;
+    double phi = player.deviation / GLICKO2_SCALE;
+    double sigma = player.volatility;
+
+    double inverse_v = 0;
+    double improvement = 0;
+    for (const GlickoResult& result : results) {
+        const GlickoRating& opponent = ratings[result.opponent];
+        double g = glicko2_g(opponent.deviation / GLICKO2_SCALE);
+        double expected = 1.0 / (1.0 + std::exp(-g * (mu - opponent.rating / GLICKO2_SCALE)));
+        inverse_v += g * g * expected * (1.0 - expected);
+        improvement += g * (result.score - expected);
+    }
+    double v = 1.0 / inverse_v;
+    double delta = v * improvement;
+
+    // The new volatility is the root of f, found with the Illinois variant of regula falsi.
+    double a = std::log(sigma * sigma);
+    auto f = [&](double x) {
+        double ex = std::exp(x);
+        double d = phi * phi + v + ex;
+        return ex * (delta * delta - phi * phi - v - ex) / (2.0 * d * d) - (x - a) / (tau * tau);
+    };
+    double low = a;
+    double high;
+    if (delta * delta > phi * phi + v) {
+        high = std::log(delta * delta - phi * phi - v);
+    } else {
+        int k = 1;
+        while (f(a - k * tau) < 0) {
+            ++k;
+        }
+        high = a - k * tau;
+    }
+    double f_low = f(low);
+    double f_high = f(high);
+    while (std::abs(high - low) > 1e-6) {
+        double next = low + (low - high) * f_low / (f_high - f_low);
+        double f_next = f(next);
+        if (f_next * f_high <= 0) {
+            low = high;
+            f_low = f_high;
+        } else {
+            f_low /= 2;
+        }
+        high = next;
+        f_high = f_next;
+    }
+    double new_sigma = std::exp(low / 2);
+
+    double phi_star = std::sqrt(phi * phi + new_sigma * new_sigma);
+    double new_phi = 1.0 / std::sqrt(1.0 / (phi_star * phi_star) + inverse_v);
+    double new_mu = mu + new_phi * new_phi * improvement;
+    return {new_mu * GLICKO2_SCALE, new_phi * GLICKO2_SCALE, new_sigma};
+}
+
+/**
+ * @brief Rates one Glicko-2 rating period. Players are updated in parallel, since each one
+ *        only depends on the ratings at the start of the period.
+ * @param ratings The ratings of all players, updated in place.
+ * @param games The games of the period.
+ * @param tau The constraint on volatility changes.
+ * @param threads The number of threads.
+ */
+void glicko2_rating_period(std::vector<GlickoRating>& ratings, std::span<const RatedGame> games, double tau, int threads) {
+    size_t players = ratings.size();
+
+    // Group the games by player: results[offsets[i], offsets[i + 1]) are player i's.
+    std::vector<size_t> offsets(players + 1, 0);
+    for (const RatedGame& game : games) {
+        offsets[game.player + 1]++;
+        offsets[game.opponent + 1]++;
+    }
+    for (size_t i = 0; i < players; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<GlickoResult> results(offsets[players]);
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (const RatedGame& game : games) {
+        results[next[game.player]++] = {game.opponent, game.score};
+        results[next[game.opponent]++] = {game.player, 1.0 - game.score};
+    }
+
+    const std::vector<GlickoRating> start = ratings;
+    // Players are handed out in blocks, so one player with many games does not hold up a whole share.
+    constexpr size_t BLOCK = 1024;
+    std::atomic<size_t> next_block{0};
+    auto rate_players = [&]() {
+        for (size_t begin; (begin = next_block.fetch_add(BLOCK)) < players;) {
+            size_t end = std::min(players, begin + BLOCK);
+            for (size_t i = begin; i < end; ++i) {
+                std::span<const GlickoResult> played(results.data() + offsets[i], offsets[i + 1] - offsets[i]);
+                if (played.empty()) {
+                    // A player who sat the period out only grows less certain.
+                    double phi = start[i].deviation / GLICKO2_SCALE;
+                    double sigma = start[i].volatility;
+                    ratings[i].deviation = std::min(MAX_DEVIATION, std::sqrt(phi * phi + sigma * sigma) * GLICKO2_SCALE);
+                } else {
+                    ratings[i] = glicko2_update(start[i], played, start, tau);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads && static_cast<size_t>(t) * BLOCK < players; ++t) {
+        workers.emplace_back(rate_players);
+    }
+    rate_players();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Constructor for the RatingEngine class.
+ * @param db_manager The database holding the ratings and games.
+ * @param config The rating settings.
+ */
+RatingEngine::RatingEngine(DatabaseManager& db_manager, const RatingConfig& config)
+    : db_manager(db_manager), config(config) {}
+
+/**
+ * @brief Archives a game against the server and rates it.
+ * @param game The game, with the player, the score and the moves filled in; the opponent is set to SERVER_NAME.
+ */
+void RatingEngine::record_result(GameRecord game) {
+    std::string player = game.player;
+    double score = game.score;
+    game.opponent = SERVER_NAME;
+    db_manager.record_game(std::move(game));
+
+    int change = 0;
+    if (config.system != "glicko2") {
+        int rating = db_manager.get_player(player).elo;
+        int server_rating = db_manager.get_player(SERVER_NAME).elo;
+        change = elo_change(rating, server_rating, score, config.k_factor);
+    }
+    // In Glicko-2 mode this only counts the game; the rating waits for the next recompute.
+    db_manager.update_or_insert_player_elo(player, change);
+    db_manager.update_or_insert_player_elo(SERVER_NAME, -change);
+}
+
+/**
+ * @brief Recomputes every Glicko-2 rating from the games table and stores them.
+ * @return The number of rated games.
+ */
+size_t RatingEngine::recompute() {
+    db_manager.flush();
+
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<std::string> names;
+    std::vector<RatedGame> games;
+    std::vector<int64_t> played_at;
+    std::string key;
+    auto id_of = [&](const char* name) {
+        key.assign(name);
+        auto [it, added] = ids.try_emplace(key, static_cast<uint32_t>(names.size()));
+        if (added) {
+            names.push_back(key);
+        }
+        return it->second;
+    };
+    db_manager.for_each_game([&](const char* player, const char* opponent, double score, int64_t time) {
+        games.push_back({id_of(player), id_of(opponent), score});
+        played_at.push_back(time);
+    });
+    if (games.empty()) {
+        return 0;
+    }
+
+    int hardware_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int threads = config.threads > 0 ? config.threads : hardware_threads;
+    int64_t period = std::max<int64_t>(1, static_cast<int64_t>(config.period_days) * 24 * 60 * 60);
+
+    // Periods run back to back from the first game; a period without games still grows every deviation.
+    std::vector<GlickoRating> ratings(names.size());
+    size_t begin = 0;
+    for (int64_t period_end = played_at.front() + period; begin < games.size(); period_end += period) {
+        size_t end = begin;
+        while (end < games.size() && played_at[end] < period_end) {
+            ++end;
+        }
+        glicko2_rating_period(ratings, std::span<const RatedGame>(games.data() + begin, end - begin), config.tau, threads);
+        begin = end;
+    }
+
+    std::vector<std::pair<std::string, PlayerRecord>> records;
+    records.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        PlayerRecord record;
+        record.elo = static_cast<int>(std::lround(ratings[i].rating));
+        record.deviation = ratings[i].deviation;
+        record.volatility = ratings[i].volatility;
+        records.emplace_back(std::move(names[i]), record);
+    }
+    db_manager.store_ratings(records);
+    return games.size();
+}
+
+/**
+ * @brief Gets the rating settings.
+ * @return The settings.
+ */
+const RatingConfig& RatingEngine::get_config() const {
+    return config;
+}
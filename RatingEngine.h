@@ -0,0 +1,134 @@
+#ifndef RATINGENGINE_H
+#define RATINGENGINE_H
+
+#include "DatabaseManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RatingConfig
+ * @brief Settings of the rating system.
+ */
+struct RatingConfig {
+    std::string system = "elo"; /**< "elo" to rate every game as it ends, "glicko2" to rate whole periods in batches. */
+    double k_factor = 32; /**< The largest Elo change of one game. */
+    double tau = 0.5; /**< The Glicko-2 constraint on how fast volatility changes. */
+    int period_days = 7; /**< The length of a Glicko-2 rating period in days. */
+    int recompute_hours = 0; /**< How often the server recomputes Glicko-2 ratings in hours, 0 for never. */
+    int threads = 0; /**< The number of threads recomputing ratings, 0 for one per hardware thread. */
+};
+
+/**
+ * @struct GlickoRating
+ * @brief A player's Glicko-2 state on the rating scale.
+ */
+struct GlickoRating {
+    double rating = 100; /**< The rating, starting where new players start. */
+    double deviation = 350; /**< The rating deviation, how uncertain the rating is. */
+    double volatility = 0.06; /**< How erratic the player's results are. */
+};
+
+/**
+ * @struct RatedGame
+ * @brief A game between two players identified by index.
+ */
+struct RatedGame {
+    uint32_t player; /**< The index of the first player. */
+    uint32_t opponent; /**< The index of the second player. */
+    double score; /**< The first player's score: 1 for a win, 0.5 for a draw, 0 for a loss. */
+};
+
+/**
+ * @struct GlickoResult
+ * @brief One game from the point of view of one player.
+ */
+struct GlickoResult {
+    uint32_t opponent; /**< The index of the opponent. */
+    double score; /**< The player's score. */
+};
+
+/**
+ * @brief Computes the Elo expected score of a player.
+ * @param rating The player's rating.
+ * @param opponent_rating The opponent's rating.
+ * @return The expected score, between 0 and 1.
+ */
+double elo_expected_score(double rating, double opponent_rating);
+
+/**
+ * @brief Computes the Elo rating change of a player after one game.
+ * @param rating The player's rating.
+ * @param opponent_rating The opponent's rating.
+ * @param score The player's score.
+ * @param k_factor The largest change.
+ * @return The rounded change; the opponent's change is its negation.
+ */
+int elo_change(int rating, int opponent_rating, double score, double k_factor);
+
+/**
+ * @brief Computes a player's Glicko-2 rating after a rating period in which they played.
+ * @param player The player's rating at the start of the period.
+ * @param results The player's games in the period.
+ * @param ratings The ratings of all players at the start of the period, indexed by player.
+ * @param tau The constraint on volatility changes.
+ * @return The rating at the end of the period.
+ */
+GlickoRating glicko2_update(const GlickoRating& player, std::span<const GlickoResult> results,
+                            const std::vector<GlickoRating>& ratings, double tau);
+
+/**
+ * @brief Rates one Glicko-2 rating period. Players are updated in parallel, since each one
+ *        only depends on the ratings at the start of the period.
+ * @param ratings The ratings of all players, updated in place.
+ * @param games The games of the period.
+ * @param tau The constraint on volatility changes.
+ * @param threads The number of threads.
+ */
+void glicko2_rating_period(std::vector<GlickoRating>& ratings, std::span<const RatedGame> games, double tau, int threads);
+
+/**
+ * @class RatingEngine
+ * @brief Turns game results into ratings stored by the DatabaseManager.
+ *
+ * Every result is recorded in the games table. In Elo mode both players' ratings also
+ * change right away; the server plays as the player SERVER_NAME. In Glicko-2 mode
+ * ratings only change when recompute rates the whole games table, period by period.
+ */
+class RatingEngine {
+public:
+    static constexpr const char* SERVER_NAME = "#server"; /**< The name the server is rated under. */
+
+    /**
+     * @brief Constructor for the RatingEngine class.
+     * @param db_manager The database holding the ratings and games.
+     * @param config The rating settings.
+     */
+    RatingEngine(DatabaseManager& db_manager, const RatingConfig& config);
+
+    /**
+     * @brief Archives a game against the server and rates it.
+     * @param game The game, with the player, the score and the moves filled in; the opponent is set to SERVER_NAME.
+     */
+    void record_result(GameRecord game);
+
+    /**
+     * @brief Recomputes every Glicko-2 rating from the games table and stores them.
+     * @return The number of rated games.
+     */
+    size_t recompute();
+
+    /**
+     * @brief Gets the rating settings.
+     * @return The settings.
+     */
+    const RatingConfig& get_config() const;
+
+private:
+    DatabaseManager& db_manager; /**< The database holding the ratings and games. */
+    RatingConfig config; /**< The rating settings. */
+};
+
+#endif // RATINGENGINE_H
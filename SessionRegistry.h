@@ -0,0 +1,186 @@
+#ifndef SESSIONREGISTRY_H
+#define SESSIONREGISTRY_H
+
+#include "websocketpp/common/connection_hdl.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @class SessionRegistry
+ * @brief A table of sessions keyed by connection handle, split into independently locked shards.
+ *
+ * Each connection hashes to one of SHARD_COUNT shards, and only that shard's mutex is
+ * taken, for the duration of a single hash map operation. Handlers of different
+ * connections therefore rarely wait on each other. The registry only guards the table;
+ * the sessions themselves are left to the connection's strand.
+ *
+ * @tparam Session The per-connection state.
+ */
+template <typename Session>
+class SessionRegistry {
+public:
+    static constexpr int SHARD_BITS = 6; /**< The number of hash bits that select a shard. */
+    static constexpr size_t SHARD_COUNT = size_t(1) << SHARD_BITS; /**< The number of shards. */
+
+    /**
+     * @brief Adds the session of a connection, replacing any previous one.
+     * @param hdl The connection handle.
+     * @param session The session.
+     * @return The number of sessions after the insertion.
+     */
+    size_t insert(websocketpp::connection_hdl hdl, std::shared_ptr<Session> session);
+
+    /**
+     * @brief Gets the session of a connection.
+     * @param hdl The connection handle.
+     * @return The session, or nullptr if the connection has none.
+     */
+    std::shared_ptr<Session> find(websocketpp::connection_hdl hdl) const;
+
+    /**
+     * @brief Removes the session of a connection.
+     * @param hdl The connection handle.
+     * @return The removed session, or nullptr if the connection had none.
+     */
+    std::shared_ptr<Session> erase(websocketpp::connection_hdl hdl);
+
+    /**
+     * @brief Gets the number of sessions.
+     * @return The session count.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @struct Shard
+     * @brief One lock and the sessions it guards, padded to its own cache line.
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex mutex; /**< Guards the sessions of this shard. */
+        std::unordered_map<const void*, std::shared_ptr<Session>> sessions; /**< The sessions by connection address. */
+    };
+
+    /**
+     * @brief Gets the key of a connection.
+     * @param hdl The connection handle.
+     * @return The address of the connection, or nullptr if it no longer exists.
+     */
+    static const void* key(websocketpp::connection_hdl hdl);
+
+    /**
+     * @brief Gets the shard a key belongs to.
+     * @param key The connection key.
+     * @return The index of the shard.
+     */
+    static size_t shard_index(const void* key);
+
+    std::array<Shard, SHARD_COUNT> shards; /**< The shards. */
+    std::atomic<size_t> count{0}; /**< The number of sessions in all shards. */
+};
+
+/**
+ * @brief Adds the session of a connection, replacing any previous one.
+ * @param hdl The connection handle.
+ * @param session The session.
+ * @return The number of sessions after the insertion.
+ */
+template <typename Session>
+size_t SessionRegistry<Session>::insert(websocketpp::connection_hdl hdl, std::shared_ptr<Session> session) {
+    const void* connection = key(hdl);
+    if (!connection) {
+        return count;
+    }
+
+    Shard& shard = shards[shard_index(connection)];
+    bool added;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        added = shard.sessions.insert_or_assign(connection, std::move(session)).second;
+    }
+    return added ? ++count : count.load();
+}
+
+/**
+ * @brief Gets the session of a connection.
+ * @param hdl The connection handle.
+ * @return The session, or nullptr if the connection has none.
+ */
+template <typename Session>
+std::shared_ptr<Session> SessionRegistry<Session>::find(websocketpp::connection_hdl hdl) const {
+    const void* connection = key(hdl);
+    if (!connection) {
+        return nullptr;
+    }
+
+    const Shard& shard = shards[shard_index(connection)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(connection);
+    return it == shard.sessions.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Removes the session of a connection.
+ * @param hdl The connection handle.
+ * @return The removed session, or nullptr if the connection had none.
+ */
+template <typename Session>
+std::shared_ptr<Session> SessionRegistry<Session>::erase(websocketpp::connection_hdl hdl) {
+    const void* connection = key(hdl);
+    if (!connection) {
+        return nullptr;
+    }
+
+    Shard& shard = shards[shard_index(connection)];
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(connection);
+        if (it == shard.sessions.end()) {
+            return nullptr;
+        }
+        session = std::move(it->second);
+        shard.sessions.erase(it);
+    }
+    --count;
+    return session;
+}
+
+/**
+ * @brief Gets the number of sessions.
+ * @return The session count.
+ */
+template <typename Session>
+size_t SessionRegistry<Session>::size() const {
+    return count;
+}
+
+/**
+ * @brief Gets the key of a connection.
+ * @param hdl The connection handle.
+ * @return The address of the connection, or nullptr if it no longer exists.
+ */
+template <typename Session>
+const void* SessionRegistry<Session>::key(websocketpp::connection_hdl hdl) {
+    // The session is erased in the close handler, while the connection is still alive,
+    // so an address is never reused for a new connection while its entry exists.
+    return hdl.lock().get();
+}
+
+/**
+ * @brief Gets the shard a key belongs to.
+ * @param key The connection key.
+ * @return The index of the shard.
+ */
+template <typename Session>
+size_t SessionRegistry<Session>::shard_index(const void* key) {
+    // Heap addresses share their low bits, so mix them before taking the top bits.
+    uint64_t address = reinterpret_cast<uintptr_t>(key);
+    return static_cast<size_t>((address * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - SHARD_BITS));
+}
+
+#endif // SESSIONREGISTRY_H
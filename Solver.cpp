@@ -0,0 +1,314 @@
+#include "Solver.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor for the Solver class.
+ * @param max_depth The maximum number of plies to look ahead, or 0 to search until the end of the game.
+ * @param table The transposition table to share with other solvers, or nullptr to search without one.
+ */
+template <typename Game>
+Solver<Game>::Solver(int max_depth, TranspositionTable* table) : max_depth(max_depth), table(table), stop_flag(nullptr), nodes(0) {
+    // Central columns take part in more lines, so they are tried first.
+    for (int i = 0; i < Game::COLUMNS; ++i) {
+        column_order[i] = Game::COLUMNS / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+    }
+}
+
+/**
+ * @brief Computes the score of a position with a null-window iterative search.
+ * @param game The position to solve.
+ * @param player The player to move.
+ * @return The score of the position for the player to move.
+ */
+template <typename Game>
+int Solver<Game>::solve(Game& game, Player player) {
+    int played = game.move_count();
+    int depth = max_depth > 0 ? max_depth : PLAYABLE_CELLS - played;
+    int min = -(PLAYABLE_CELLS - played) / 2;
+    int max = (PLAYABLE_CELLS + 1 - played) / 2;
+
+    // Narrow [min, max] with null-window searches, probing near zero first because
+    // those searches are the cheapest.
+    while (min < max) {
+        int med = min + (max - min) / 2;
+        if (med <= 0 && min / 2 < med) {
+            med = min / 2;
+        } else if (med >= 0 && max / 2 > med) {
+            med = max / 2;
+        }
+
+        int score = negamax(game, player, med, med + 1, depth);
+        if (stopped()) {
+            break;
+        }
+        if (score <= med) {
+            max = score;
+        } else {
+            min = score;
+        }
+    }
+    return min;
+}
+
+/**
+ * @brief Finds a move that achieves the score of the position.
+ * @param game The position to play from.
+ * @param player The player to move.
+ * @return The column of the best move, preferring central columns among equal moves, or -1 if the board is full.
+ */
+template <typename Game>
+int Solver<Game>::best_move(Game& game, Player player) {
+    if (game.is_full()) {
+        return -1;
+    }
+
+    for (int column : column_order) {
+        if (is_winning_move(game, player, column)) {
+            return column;
+        }
+    }
+
+    int score = solve(game, player);
+    int depth = max_depth > 0 ? max_depth : PLAYABLE_CELLS - game.move_count();
+    int fallback = -1;
+
+    for (int column : column_order) {
+        if (!game.make_move(player, column)) {
+            continue;
+        }
+        // The move keeps the score if the opponent cannot get more than -score after it.
+        bool keeps_score = negamax(game, opponent(player), -score, -score + 1, depth - 1) <= -score;
+        game.undo_move();
+
+        if (keeps_score) {
+            return column;
+        }
+        if (fallback < 0) {
+            fallback = column;
+        }
+    }
+    return fallback;
+}
+
+/**
+ * @brief Gets the number of positions visited since the solver was created or last reset.
+ * @return The node count.
+ */
+template <typename Game>
+uint64_t Solver<Game>::node_count() const {
+    return nodes;
+}
+
+/**
+ * @brief Resets the node count to zero.
+ */
+template <typename Game>
+void Solver<Game>::reset_node_count() {
+    nodes = 0;
+}
+
+/**
+ * @brief Sets a flag that aborts the search once raised.
+ * @param flag The stop flag, or nullptr to never abort.
+ */
+template <typename Game>
+void Solver<Game>::set_stop_flag(const std::atomic<bool>* flag) {
+    stop_flag = flag;
+}
+
+/**
+ * @brief Rotates the center-first column order.
+ * @param shift The number of positions to rotate the order by.
+ */
+template <typename Game>
+void Solver<Game>::rotate_column_order(int shift) {
+    std::rotate(column_order.begin(), column_order.begin() + shift % Game::COLUMNS, column_order.end());
+}
+
+/**
+ * @brief Searches a position within an alpha-beta window.
+ * @param game The position to search.
+ * @param player The player to move.
+ * @param alpha The score the player to move is already guaranteed.
+ * @param beta The score the opponent is already guaranteed to hold the player to.
+ * @param depth The remaining number of plies to look ahead.
+ * @return The exact score if it lies inside the window, otherwise a bound beyond the window edge it crossed.
+ */
+template <typename Game>
+int Solver<Game>::negamax(Game& game, Player player, int alpha, int beta, int depth) {
+    ++nodes;
+    if (stopped()) {
+        return 0;
+    }
+
+    int played = game.move_count();
+    if (played == PLAYABLE_CELLS) {
+        return 0;
+    }
+
+    for (int column = 0; column < Game::COLUMNS; ++column) {
+        if (is_winning_move(game, player, column)) {
+            return (PLAYABLE_CELLS + 1 - played) / 2;
+        }
+    }
+
+    // A square the opponent would win on must be blocked; two of them cannot be.
+    Player other = opponent(player);
+    int threats = 0;
+    int forced_column = -1;
+    for (int column = 0; column < Game::COLUMNS; ++column) {
+        if (is_winning_move(game, other, column)) {
+            ++threats;
+            forced_column = column;
+        }
+    }
+    if (threats > 1) {
+        return -(PLAYABLE_CELLS - played) / 2;
+    }
+
+    if (depth <= 0) {
+        return 0;
+    }
+
+    // Looking further ahead than the end of the game changes nothing, so such results are exact.
+    if (depth > PLAYABLE_CELLS - played) {
+        depth = PLAYABLE_CELLS - played;
+    }
+
+    int window_alpha = alpha;
+    int window_beta = beta;
+    int table_move = -1;
+    uint64_t key = 0;
+    if (table) {
+        key = table_key(game, player);
+        TranspositionTable::Entry entry;
+        if (table->probe(key, entry)) {
+            table_move = game.canonical_column(entry.best_move);
+            if (entry.depth >= depth) {
+                if (entry.bound == TranspositionTable::EXACT) {
+                    return entry.score;
+                } else if (entry.bound == TranspositionTable::LOWER) {
+                    if (entry.score >= beta) {
+                        return entry.score;
+                    }
+                    if (entry.score > alpha) {
+                        alpha = entry.score;
+                    }
+                } else if (entry.bound == TranspositionTable::UPPER) {
+                    if (entry.score <= alpha) {
+                        return entry.score;
+                    }
+                    if (entry.score < beta) {
+                        beta = entry.score;
+                    }
+                }
+            }
+        }
+    }
+
+    // The player cannot win with the next disc, so the score is at most that of a win one move later.
+    int max = (PLAYABLE_CELLS - 1 - played) / 2;
+    if (beta > max) {
+        beta = max;
+        if (alpha >= beta) {
+            return beta;
+        }
+    }
+
+    int best_score = alpha;
+    int best_column = -1;
+    for (int i = -1; i < Game::COLUMNS; ++i) {
+        // The table's best move goes first, then the columns from the center outwards.
+        int column = i < 0 ? table_move : column_order[i];
+        if (column < 0 || (i >= 0 && column == table_move)) {
+            continue;
+        }
+        if (forced_column >= 0 && column != forced_column) {
+            continue;
+        }
+        if (!game.make_move(player, column)) {
+            continue;
+        }
+        int score = -negamax(game, other, -beta, -alpha, depth - 1);
+        game.undo_move();
+
+        if (stopped()) {
+            return 0;
+        }
+        if (score >= beta) {
+            best_score = score;
+            best_column = column;
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            best_score = score;
+            best_column = column;
+        }
+    }
+
+    if (table) {
+        // Classify against the caller's window, which the table bounds can only have narrowed.
+        TranspositionTable::Bound bound = TranspositionTable::EXACT;
+        if (best_score <= window_alpha) {
+            bound = TranspositionTable::UPPER;
+        } else if (best_score >= window_beta) {
+            bound = TranspositionTable::LOWER;
+        }
+        table->store(key, best_score, bound, game.canonical_column(best_column), depth);
+    }
+    return best_score;
+}
+
+/**
+ * @brief Checks if dropping a disc in a column wins the game for a player.
+ * @param game The position to check.
+ * @param player The player dropping the disc.
+ * @param column The column to drop the disc in.
+ * @return True if the move is possible and wins, false otherwise.
+ */
+template <typename Game>
+bool Solver<Game>::is_winning_move(Game& game, Player player, int column) {
+    if (!game.make_move(player, column)) {
+        return false;
+    }
+    bool win = game.last_move_wins();
+    game.undo_move();
+    return win;
+}
+
+/**
+ * @brief Checks if the stop flag has been raised.
+ * @return True if the search must abort, false otherwise.
+ */
+template <typename Game>
+bool Solver<Game>::stopped() const {
+    return stop_flag && stop_flag->load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the transposition table key of a position.
+ * @param game The position.
+ * @param player The player to move.
+ * @return The canonical position hash combined with the player to move.
+ */
+template <typename Game>
+uint64_t Solver<Game>::table_key(const Game& game, Player player) {
+    uint64_t hash = game.canonical_hash();
+    return player == Player::CLIENT ? hash ^ UINT64_C(0xA5A5A5A5A5A5A5A5) : hash;
+}
+
+/**
+ * @brief Gets the other player.
+ * @param player A player.
+ * @return The opponent of the player.
+ */
+template <typename Game>
+Player Solver<Game>::opponent(Player player) {
+    return player == Player::CLIENT ? Player::SERVER : Player::CLIENT;
+}
+
+template class Solver<ConnectFourGame<6, 7, 4>>;
+template class Solver<ConnectFourGame<7, 8, 4>>;
+template class Solver<ConnectFourGame<8, 9, 4>>;
+template class Solver<ConnectFourGame<6, 9, 5>>;
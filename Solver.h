@@ -0,0 +1,132 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "ConnectFourGame.h"
+#include "TranspositionTable.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class Solver
+ * @brief A negamax solver with alpha-beta pruning for ConnectFourGame positions.
+ *
+ * Scores are from the point of view of the player to move: a positive score means
+ * that player wins, and the sooner the win the higher the score. A win with the
+ * player's last disc scores 1, a draw scores 0 and a loss is negative.
+ *
+ * @tparam Game The ConnectFourGame variant to solve.
+ */
+template <typename Game>
+class Solver {
+public:
+    static constexpr int PLAYABLE_CELLS = Game::ROWS * Game::COLUMNS; /**< The number of cells on the board. */
+    static constexpr int MIN_SCORE = -PLAYABLE_CELLS / 2; /**< A lower bound on every score. */
+    static constexpr int MAX_SCORE = (PLAYABLE_CELLS + 1) / 2; /**< An upper bound on every score. */
+
+    /**
+     * @brief Constructor for the Solver class.
+     * @param max_depth The maximum number of plies to look ahead, or 0 to search until the end of the game.
+     * @param table The transposition table to share with other solvers, or nullptr to search without one.
+     */
+    explicit Solver(int max_depth = 0, TranspositionTable* table = nullptr);
+
+    /**
+     * @brief Computes the score of a position with a null-window iterative search.
+     *
+     * The game is searched in place and restored before returning. With a depth limit,
+     * positions beyond the horizon count as draws, so the score is only exact when it
+     * is a win or a loss found within the horizon.
+     * @param game The position to solve.
+     * @param player The player to move.
+     * @return The score of the position for the player to move.
+     */
+    int solve(Game& game, Player player);
+
+    /**
+     * @brief Finds a move that achieves the score of the position.
+     * @param game The position to play from.
+     * @param player The player to move.
+     * @return The column of the best move, preferring central columns among equal moves, or -1 if the board is full.
+     */
+    int best_move(Game& game, Player player);
+
+    /**
+     * @brief Gets the number of positions visited since the solver was created or last reset.
+     * @return The node count.
+     */
+    uint64_t node_count() const;
+
+    /**
+     * @brief Resets the node count to zero.
+     */
+    void reset_node_count();
+
+    /**
+     * @brief Sets a flag that aborts the search once raised. An aborted search stores
+     * nothing in the transposition table and its result must be discarded.
+     * @param flag The stop flag, or nullptr to never abort.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * @brief Rotates the center-first column order, so that parallel searches explore the tree in different orders.
+     * @param shift The number of positions to rotate the order by.
+     */
+    void rotate_column_order(int shift);
+
+private:
+    /**
+     * @brief Searches a position within an alpha-beta window.
+     * @param game The position to search.
+     * @param player The player to move.
+     * @param alpha The score the player to move is already guaranteed.
+     * @param beta The score the opponent is already guaranteed to hold the player to.
+     * @param depth The remaining number of plies to look ahead.
+     * @return The exact score if it lies inside the window, otherwise a bound beyond the window edge it crossed.
+     */
+    int negamax(Game& game, Player player, int alpha, int beta, int depth);
+
+    /**
+     * @brief Checks if dropping a disc in a column wins the game for a player.
+     * @param game The position to check.
+     * @param player The player dropping the disc.
+     * @param column The column to drop the disc in.
+     * @return True if the move is possible and wins, false otherwise.
+     */
+    static bool is_winning_move(Game& game, Player player, int column);
+
+    /**
+     * @brief Checks if the stop flag has been raised.
+     * @return True if the search must abort, false otherwise.
+     */
+    bool stopped() const;
+
+    /**
+     * @brief Gets the transposition table key of a position.
+     * @param game The position.
+     * @param player The player to move.
+     * @return The canonical position hash combined with the player to move.
+     */
+    static uint64_t table_key(const Game& game, Player player);
+
+    /**
+     * @brief Gets the other player.
+     * @param player A player.
+     * @return The opponent of the player.
+     */
+    static Player opponent(Player player);
+
+    int max_depth; /**< The maximum number of plies to look ahead, 0 for no limit. */
+    TranspositionTable* table; /**< The shared transposition table, or nullptr. */
+    const std::atomic<bool>* stop_flag; /**< Aborts the search once raised, or nullptr. */
+    uint64_t nodes; /**< The number of positions visited. */
+    std::array<int, Game::COLUMNS> column_order; /**< The columns sorted from the center outwards. */
+};
+
+extern template class Solver<ConnectFourGame<6, 7, 4>>;
+extern template class Solver<ConnectFourGame<7, 8, 4>>;
+extern template class Solver<ConnectFourGame<8, 9, 4>>;
+extern template class Solver<ConnectFourGame<6, 9, 5>>;
+
+#endif // SOLVER_H
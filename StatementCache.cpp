@@ -0,0 +1,79 @@
+#include "StatementCache.h"
+#include <iostream>
+
+/**
+ * @brief Constructor for the Statement class.
+ * @param stmt The prepared statement, or nullptr if preparing it failed.
+ */
+StatementCache::Statement::Statement(sqlite3_stmt* stmt) : stmt(stmt) {}
+
+/**
+ * @brief Destructor for the Statement class. Resets the statement and clears its bindings.
+ */
+StatementCache::Statement::~Statement() {
+    if (stmt) {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+}
+
+/**
+ * @brief Gets the prepared statement.
+ * @return The statement, or nullptr if preparing it failed.
+ */
+sqlite3_stmt* StatementCache::Statement::get() const {
+    return stmt;
+}
+
+/**
+ * @brief Runs a statement that returns no rows.
+ * @return True if the statement ran to completion, false otherwise.
+ */
+bool StatementCache::Statement::execute() {
+    return stmt && sqlite3_step(stmt) == SQLITE_DONE;
+}
+
+/**
+ * @brief Constructor for the StatementCache class. Creates a cache without a connection.
+ */
+StatementCache::StatementCache() : connection(nullptr) {}
+
+/**
+ * @brief Destructor for the StatementCache class. Finalizes every cached statement.
+ */
+StatementCache::~StatementCache() {
+    attach(nullptr);
+}
+
+/**
+ * @brief Finalizes every cached statement and starts caching statements of another connection.
+ * @param connection The connection, or nullptr to only finalize.
+ */
+void StatementCache::attach(sqlite3* connection) {
+    for (auto& [sql, stmt] : statements) {
+        sqlite3_finalize(stmt);
+    }
+    statements.clear();
+    this->connection = connection;
+}
+
+/**
+ * @brief Gets a statement, preparing it on first use.
+ * @param sql The SQL text of the statement, which must outlive the cache.
+ * @return The statement, which holds nullptr if it could not be prepared.
+ */
+StatementCache::Statement StatementCache::get(const char* sql) {
+    auto it = statements.find(sql);
+    if (it != statements.end()) {
+        return Statement(it->second);
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (!connection || sqlite3_prepare_v2(connection, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to prepare statement: " << (connection ? sqlite3_errmsg(connection) : "no connection") << std::endl;
+        sqlite3_finalize(stmt);
+        return Statement(nullptr);
+    }
+    statements.emplace(sql, stmt);
+    return Statement(stmt);
+}
@@ -0,0 +1,87 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <sqlite3.h>
+#include <unordered_map>
+
+/**
+ * @class StatementCache
+ * @brief Prepares each SQL statement of a connection once and keeps it for reuse.
+ *
+ * Statements are looked up by the address of their SQL text, so a lookup neither copies
+ * nor hashes the text: the text must be a string literal or another constant that outlives
+ * the cache, and the same text at two addresses is prepared twice. Users hold a StatementCache::Statement,
+ * which resets the statement and clears its bindings when it goes out of scope, so the
+ * next user starts from a clean statement and no read stays open between uses. A cache
+ * is not thread-safe: the users of a connection must take turns.
+ */
+class StatementCache {
+public:
+    /**
+     * @class Statement
+     * @brief A cached statement lent out until the end of the scope.
+     */
+    class Statement {
+    public:
+        /**
+         * @brief Constructor for the Statement class.
+         * @param stmt The prepared statement, or nullptr if preparing it failed.
+         */
+        explicit Statement(sqlite3_stmt* stmt);
+
+        /**
+         * @brief Destructor for the Statement class. Resets the statement and clears its bindings.
+         */
+        ~Statement();
+
+        Statement(const Statement&) = delete;
+        Statement& operator=(const Statement&) = delete;
+
+        /**
+         * @brief Gets the prepared statement.
+         * @return The statement, or nullptr if preparing it failed.
+         */
+        sqlite3_stmt* get() const;
+
+        /**
+         * @brief Runs a statement that returns no rows.
+         * @return True if the statement ran to completion, false otherwise.
+         */
+        bool execute();
+
+    private:
+        sqlite3_stmt* stmt; /**< The lent statement. */
+    };
+
+    /**
+     * @brief Constructor for the StatementCache class. Creates a cache without a connection.
+     */
+    StatementCache();
+
+    /**
+     * @brief Destructor for the StatementCache class. Finalizes every cached statement.
+     */
+    ~StatementCache();
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    /**
+     * @brief Finalizes every cached statement and starts caching statements of another connection.
+     * @param connection The connection, or nullptr to only finalize.
+     */
+    void attach(sqlite3* connection);
+
+    /**
+     * @brief Gets a statement, preparing it on first use.
+     * @param sql The SQL text of the statement, which must outlive the cache.
+     * @return The statement, which holds nullptr if it could not be prepared.
+     */
+    Statement get(const char* sql);
+
+private:
+    sqlite3* connection; /**< The connection the statements belong to. */
+    std::unordered_map<const char*, sqlite3_stmt*> statements; /**< The prepared statements by the address of their SQL text. */
+};
+
+#endif // STATEMENTCACHE_H
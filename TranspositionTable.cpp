@@ -0,0 +1,122 @@
+#include "TranspositionTable.h"
+
+/**
+ * @brief Constructor for the TranspositionTable class. Allocates an empty table.
+ * @param size_mb The table size in megabytes, rounded down to a power-of-two number of buckets.
+ */
+TranspositionTable::TranspositionTable(size_t size_mb) {
+    size_t target = size_mb * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= target) {
+        count *= 2;
+    }
+    buckets = std::make_unique<Bucket[]>(count);
+    index_mask = count - 1;
+}
+
+/**
+ * @brief Looks up a position.
+ * @param key The position hash.
+ * @param entry Receives the stored entry on a hit.
+ * @return True if the position was found, false otherwise.
+ */
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+    const Bucket& bucket = buckets[key & index_mask];
+    return read_slot(bucket.depth_preferred, key, entry) || read_slot(bucket.always_replace, key, entry);
+}
+
+/**
+ * @brief Stores a search result.
+ * @param key The position hash.
+ * @param score The score found by the search, which must fit in a signed byte.
+ * @param bound How the score bounds the true score.
+ * @param best_move The best column found, or -1 if none.
+ * @param depth The number of plies the search looked ahead, capped at 255.
+ */
+void TranspositionTable::store(uint64_t key, int score, Bound bound, int best_move, int depth) {
+    Bucket& bucket = buckets[key & index_mask];
+    uint64_t data = pack(score, bound, best_move, depth);
+
+    uint64_t current = bucket.depth_preferred.data.load(std::memory_order_relaxed);
+    uint64_t current_key = bucket.depth_preferred.key_xor_data.load(std::memory_order_relaxed) ^ current;
+    if (current_key == key || unpack(data).depth >= unpack(current).depth) {
+        write_slot(bucket.depth_preferred, key, data);
+    } else {
+        write_slot(bucket.always_replace, key, data);
+    }
+}
+
+/**
+ * @brief Empties the table. Must not run concurrently with probes or stores.
+ */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= index_mask; ++i) {
+        write_slot(buckets[i].depth_preferred, 0, 0);
+        write_slot(buckets[i].always_replace, 0, 0);
+    }
+}
+
+/**
+ * @brief Gets the number of buckets in the table.
+ * @return The bucket count.
+ */
+size_t TranspositionTable::bucket_count() const {
+    return index_mask + 1;
+}
+
+/**
+ * @brief Packs an entry into 64 bits: score, bound, best move and depth, one byte each.
+ * @param score The score.
+ * @param bound The bound type.
+ * @param best_move The best column, or -1 if none.
+ * @param depth The search depth.
+ * @return The packed entry.
+ */
+uint64_t TranspositionTable::pack(int score, Bound bound, int best_move, int depth) {
+    return static_cast<uint64_t>(static_cast<uint8_t>(score)) |
+           static_cast<uint64_t>(bound) << 8 |
+           static_cast<uint64_t>(static_cast<uint8_t>(best_move)) << 16 |
+           static_cast<uint64_t>(depth > 255 ? 255 : depth) << 24;
+}
+
+/**
+ * @brief Unpacks an entry packed by pack().
+ * @param data The packed entry.
+ * @return The unpacked entry.
+ */
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) {
+    Entry entry;
+    entry.score = static_cast<int8_t>(data & 0xFF);
+    entry.bound = static_cast<Bound>((data >> 8) & 0xFF);
+    entry.best_move = static_cast<int8_t>((data >> 16) & 0xFF);
+    entry.depth = static_cast<int>((data >> 24) & 0xFF);
+    return entry;
+}
+
+/**
+ * @brief Checks a slot for a key.
+ * @param slot The slot to read.
+ * @param key The position hash.
+ * @param entry Receives the stored entry if the slot holds the key.
+ * @return True if the slot holds a valid entry for the key, false otherwise.
+ */
+bool TranspositionTable::read_slot(const Slot& slot, uint64_t key, Entry& entry) {
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t key_xor_data = slot.key_xor_data.load(std::memory_order_relaxed);
+    if ((key_xor_data ^ data) != key) {
+        return false;
+    }
+    entry = unpack(data);
+    return entry.bound != Bound::NONE;
+}
+
+/**
+ * @brief Overwrites a slot.
+ * @param slot The slot to write.
+ * @param key The position hash.
+ * @param data The packed entry.
+ */
+void TranspositionTable::write_slot(Slot& slot, uint64_t key, uint64_t data) {
+    slot.key_xor_data.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
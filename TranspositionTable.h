@@ -0,0 +1,136 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TranspositionTable
+ * @brief A fixed-size table of search results keyed by position hash, shared between threads.
+ *
+ * Every bucket holds a depth-preferred slot and an always-replace slot and is 32 bytes
+ * wide, so a bucket never straddles a cache line. Each slot stores its packed entry next
+ * to the entry XORed with the key. A reader only accepts a slot whose two words still
+ * XOR back to the probed key, so torn writes from concurrent threads are detected and
+ * treated as misses, without any locking.
+ */
+class TranspositionTable {
+public:
+    /**
+     * @enum Bound
+     * @brief Describes how a stored score relates to the true score of the position.
+     */
+    enum Bound : uint8_t {
+        NONE = 0,  /**< The slot is empty */
+        EXACT = 1, /**< The score is exact */
+        LOWER = 2, /**< The true score is at least the stored score */
+        UPPER = 3  /**< The true score is at most the stored score */
+    };
+
+    /**
+     * @struct Entry
+     * @brief The unpacked contents of a table slot.
+     */
+    struct Entry {
+        int score;     /**< The score found by the search */
+        Bound bound;   /**< How the score bounds the true score */
+        int best_move; /**< The best column found, or -1 if none */
+        int depth;     /**< The number of plies the search looked ahead */
+    };
+
+    /**
+     * @brief Constructor for the TranspositionTable class. Allocates an empty table.
+     * @param size_mb The table size in megabytes, rounded down to a power-of-two number of buckets.
+     */
+    explicit TranspositionTable(size_t size_mb);
+
+    /**
+     * @brief Looks up a position.
+     * @param key The position hash.
+     * @param entry Receives the stored entry on a hit.
+     * @return True if the position was found, false otherwise.
+     */
+    bool probe(uint64_t key, Entry& entry) const;
+
+    /**
+     * @brief Stores a search result. It replaces the depth-preferred slot if the new result
+     * is at least as deep or for the same position, and the always-replace slot otherwise.
+     * @param key The position hash.
+     * @param score The score found by the search, which must fit in a signed byte.
+     * @param bound How the score bounds the true score.
+     * @param best_move The best column found, or -1 if none.
+     * @param depth The number of plies the search looked ahead, capped at 255.
+     */
+    void store(uint64_t key, int score, Bound bound, int best_move, int depth);
+
+    /**
+     * @brief Empties the table. Must not run concurrently with probes or stores.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of buckets in the table.
+     * @return The bucket count.
+     */
+    size_t bucket_count() const;
+
+private:
+    /**
+     * @struct Slot
+     * @brief A packed entry and the same entry XORed with its key.
+     */
+    struct Slot {
+        std::atomic<uint64_t> key_xor_data{0}; /**< The key XORed with the packed entry. */
+        std::atomic<uint64_t> data{0}; /**< The packed entry. */
+    };
+
+    /**
+     * @struct Bucket
+     * @brief The two slots a key can be stored in.
+     */
+    struct alignas(32) Bucket {
+        Slot depth_preferred; /**< Keeps the deepest result seen for this bucket. */
+        Slot always_replace; /**< Keeps the most recent shallower result. */
+    };
+
+    /**
+     * @brief Packs an entry into 64 bits: score, bound, best move and depth, one byte each.
+     * @param score The score.
+     * @param bound The bound type.
+     * @param best_move The best column, or -1 if none.
+     * @param depth The search depth.
+     * @return The packed entry.
+     */
+    static uint64_t pack(int score, Bound bound, int best_move, int depth);
+
+    /**
+     * @brief Unpacks an entry packed by pack().
+     * @param data The packed entry.
+     * @return The unpacked entry.
+     */
+    static Entry unpack(uint64_t data);
+
+    /**
+     * @brief Checks a slot for a key.
+     * @param slot The slot to read.
+     * @param key The position hash.
+     * @param entry Receives the stored entry if the slot holds the key.
+     * @return True if the slot holds a valid entry for the key, false otherwise.
+     */
+    static bool read_slot(const Slot& slot, uint64_t key, Entry& entry);
+
+    /**
+     * @brief Overwrites a slot.
+     * @param slot The slot to write.
+     * @param key The position hash.
+     * @param data The packed entry.
+     */
+    static void write_slot(Slot& slot, uint64_t key, uint64_t data);
+
+    std::unique_ptr<Bucket[]> buckets; /**< The table storage. */
+    size_t index_mask; /**< The bucket count minus one, used to map keys to buckets. */
+};
+
+#endif // TRANSPOSITIONTABLE_H
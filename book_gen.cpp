@@ -0,0 +1,113 @@
+#include "OpeningBook.h"
+#include "ParallelSolver.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Collects every position reachable within a number of moves, the server moving first.
+ *
+ * Mirror images count as the same position, so only one of each pair is kept.
+ * @param game The position to expand, restored before returning.
+ * @param player The player to move.
+ * @param plies The number of moves still allowed.
+ * @param seen The canonical hashes of the positions collected so far.
+ * @param positions Receives one copy of every new position.
+ */
+template <typename Game>
+void collect_positions(Game& game, Player player, int plies, std::unordered_set<uint64_t>& seen, std::vector<Game>& positions) {
+    if (!seen.insert(game.canonical_hash()).second) {
+        return;
+    }
+    positions.push_back(game);
+
+    if (plies == 0) {
+        return;
+    }
+    Player next = player == Player::SERVER ? Player::CLIENT : Player::SERVER;
+    for (int column = 0; column < Game::COLUMNS; ++column) {
+        if (!game.make_move(player, column)) {
+            continue;
+        }
+        if (!game.last_move_wins() && !game.is_full()) {
+            collect_positions(game, next, plies - 1, seen, positions);
+        }
+        game.undo_move();
+    }
+}
+
+/**
+ * @brief Solves every collected position and writes the book.
+ * @param path The path of the book file.
+ * @param plies The book depth.
+ * @param solver_depth The solver's look-ahead in plies, 0 to solve to the end of the game.
+ * @param threads The number of solver threads.
+ * @return True if the book was written, false otherwise.
+ */
+template <typename Game>
+bool generate_book(const std::string& path, int plies, int solver_depth, int threads) {
+    Game game;
+    std::unordered_set<uint64_t> seen;
+    std::vector<Game> positions;
+    collect_positions(game, Player::SERVER, plies, seen, positions);
+    std::cout << "Solving " << positions.size() << " positions..." << std::endl;
+
+    TranspositionTable table(256);
+    ParallelSolver<Game> solver(threads, solver_depth, &table);
+    std::vector<uint64_t> entries;
+    entries.reserve(positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const Game& position = positions[i];
+        Player player = position.move_count() % 2 == 0 ? Player::SERVER : Player::CLIENT;
+        int score = solver.solve(position, player);
+        int best_move = solver.best_move(position, player);
+        entries.push_back(OpeningBook::pack(position.canonical_hash(), position.canonical_column(best_move), score));
+
+        if ((i + 1) % 1000 == 0) {
+            std::cout << "Solved " << i + 1 << " / " << positions.size() << std::endl;
+        }
+    }
+
+    return OpeningBook::write(path, Game::ROWS, Game::COLUMNS, Game::WIN_CONDITION, plies, entries);
+}
+
+/**
+ * @brief Main function of the opening book generator.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments.
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output_file> <plies> [solver_depth] [threads] [rows] [columns] [win_condition]" << std::endl;
+        return 1;
+    }
+
+    std::string path = argv[1];
+    int plies = std::atoi(argv[2]);
+    int solver_depth = argc > 3 ? std::atoi(argv[3]) : 0;
+    int threads = argc > 4 ? std::atoi(argv[4]) : 1;
+    int rows = argc > 5 ? std::atoi(argv[5]) : 6;
+    int columns = argc > 6 ? std::atoi(argv[6]) : 7;
+    int win_condition = argc > 7 ? std::atoi(argv[7]) : 4;
+
+    bool written = false;
+    bool supported = dispatch_game_variant(rows, columns, win_condition, [&](auto variant) {
+        using Game = typename decltype(variant)::type;
+        written = generate_book<Game>(path, plies, solver_depth, threads);
+    });
+
+    if (!supported) {
+        std::cerr << "Unsupported board: " << rows << "x" << columns << " with " << win_condition << " in a row." << std::endl;
+        return 1;
+    }
+    if (!written) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << path << std::endl;
+    return 0;
+}
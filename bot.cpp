@@ -1,10 +1,12 @@
 #include "Bot.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
 #include <iostream>
 
 /**
  * @brief Constructor for the Bot class. Initializes the connection state and game state variables.
  */
-Bot::Bot(): connection_open(false), my_turn(false), game_over(false), last_result_valid(true) {}
+Bot::Bot(): connection_open(false), my_turn(false), game_over(false), last_result_valid(true), columns(7), binary(false), seq(0), awaiting_board(false) {}
 
 /**
  * @brief Runs the bot by connecting to the server at the specified URI and starting the WebSocket client.
@@ -26,6 +28,7 @@ void Bot::run(const std::string& uri) {
         std::cerr << "Could not create connection because: " << ec.message() << std::endl;
         return;
     }
+    con->add_subprotocol(BINARY_SUBPROTOCOL);
 
     ws_client.connect(con);
 
@@ -51,6 +54,8 @@ void Bot::on_open(client* c, websocketpp::connection_hdl hdl) {
     connection_open = true;
     connection_cv.notify_one();
 
+    binary = c->get_con_from_hdl(hdl)->get_response_header("Sec-WebSocket-Protocol") == BINARY_SUBPROTOCOL;
+
     Json::Value name_message;
     name_message["type"] = "player_name";
     name_message["name"] = player_name;
@@ -65,11 +70,14 @@ void Bot::on_open(client* c, websocketpp::connection_hdl hdl) {
  * @param msg The message received from the server.
  */
 void Bot::on_message(client* c, websocketpp::connection_hdl hdl, client::message_ptr msg) {
+    if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+        on_binary_message(c, hdl, msg->get_payload());
+        return;
+    }
+
     Json::Value root;
-    Json::CharReaderBuilder reader;
     std::string errs;
-    std::istringstream stream(msg->get_payload());
-    if (!Json::parseFromStream(reader, stream, &root, &errs)) {
+    if (!parse_json(msg->get_payload(), root, &errs)) {
         std::cerr << "Failed to parse message: " << errs << std::endl;
         return;
     }
@@ -79,8 +87,47 @@ void Bot::on_message(client* c, websocketpp::connection_hdl hdl, client::message
         handle_game_start();
     } else if (message_type == "move_result") {
         handle_move_result(c, hdl, root);
+    } else if (message_type == "board") {
+        handle_board(root["board"], root["seq"].asInt());
     } else if (message_type == "your_turn") {
         handle_your_turn(c, hdl);
+    } else if (message_type == "game_over") {
+        handle_game_over(root["winner"].asInt());
+    }
+}
+
+/**
+ * @brief Handles a binary frame from the server and calls the appropriate handler based on its type.
+ * @param c Pointer to the WebSocket client.
+ * @param hdl The connection handle.
+ * @param payload The frame.
+ */
+void Bot::on_binary_message(client* c, websocketpp::connection_hdl hdl, const std::string& payload) {
+    GameStartFrame start;
+    BoardFrame snapshot;
+    MoveResultFrame result;
+    GameOverFrame over;
+    if (decode_frame(payload, start)) {
+        columns = start.columns;
+        handle_game_start();
+    } else if (decode_frame(payload, snapshot)) {
+        Json::Value snapshot_json(Json::arrayValue);
+        for (int row = 0; row < snapshot.rows; ++row) {
+            Json::Value row_json(Json::arrayValue);
+            for (int column = 0; column < snapshot.columns; ++column) {
+                row_json.append(snapshot.cells[row * snapshot.columns + column]);
+            }
+            snapshot_json.append(row_json);
+        }
+        handle_board(snapshot_json, snapshot.seq);
+    } else if (decode_frame(payload, result)) {
+        handle_move_result(c, hdl, result);
+    } else if (frame_type(payload) == FrameType::YOUR_TURN) {
+        handle_your_turn(c, hdl);
+    } else if (decode_frame(payload, over)) {
+        handle_game_over(over.winner);
+    } else {
+        std::cerr << "Failed to parse binary frame." << std::endl;
     }
 }
 
@@ -107,21 +154,89 @@ void Bot::handle_move_result(client* c, websocketpp::connection_hdl hdl, const J
         return;
     }
 
-    last_result_valid = true;
+    apply_move(c, hdl, root["column"].asInt(), root["row"].asInt(), root["player"].asInt(), root["seq"].asInt());
 
-    if (root.isMember("board")) {
-        print_board(root["board"]);
-    }
-    
     bool win = root["win"].asBool();
     if (win) {
-        if (root["winner"].asInt() == Player::CLIENT) {
-            std::cout << "You won the game!" << std::endl;
-        } else {
-            std::cout << "You lost the game!" << std::endl;
-        }
-        game_over = true;
+        handle_game_over(root["winner"].asInt());
+    }
+}
+
+/**
+ * @brief Handles the binary result of a move. Applies the move or asks for another move.
+ * @param c Pointer to the WebSocket client.
+ * @param hdl The connection handle.
+ * @param result The move result frame.
+ */
+void Bot::handle_move_result(client* c, websocketpp::connection_hdl hdl, const MoveResultFrame& result) {
+    if (result.status != MoveStatus::PLAYED) {
+        std::cout << "Error: Invalid move. Please try a different column." << std::endl;
+        my_turn = true;
+        last_result_valid = false;
+        handle_your_turn(c, hdl);
+        return;
+    }
+
+    apply_move(c, hdl, result.column, result.row, result.player, result.seq);
+}
+
+/**
+ * @brief Applies a move to the board. Asks the server for the whole board if a move was missed.
+ * @param c Pointer to the WebSocket client.
+ * @param hdl The connection handle.
+ * @param column The column played.
+ * @param row The row the disc landed in, counted from the top.
+ * @param player The player who moved.
+ * @param move_seq The sequence number of the move.
+ */
+void Bot::apply_move(client* c, websocketpp::connection_hdl hdl, int column, int row, int player, int move_seq) {
+    last_result_valid = true;
+    if (awaiting_board) {
+        // The requested board already includes this move.
+        return;
+    }
+
+    if (move_seq != seq + 1 || row < 0 || row >= static_cast<int>(board.size()) ||
+        column < 0 || column >= static_cast<int>(board[row].size())) {
+        std::cout << "Missed a move. Asking the server for the board..." << std::endl;
+        awaiting_board = true;
+        send_board_request(c, hdl);
+        return;
+    }
+
+    board[row][column] = player;
+    seq = move_seq;
+    print_board(board);
+}
+
+/**
+ * @brief Replaces the board with a snapshot from the server.
+ * @param snapshot The board, row by row from the top.
+ * @param snapshot_seq The sequence number of the last move on the board.
+ */
+void Bot::handle_board(const Json::Value& snapshot, int snapshot_seq) {
+    board = snapshot;
+    if (!board.empty()) {
+        columns = board[0].size();
+    }
+    seq = snapshot_seq;
+    awaiting_board = false;
+    print_board(board);
+}
+
+/**
+ * @brief Handles the end of the game. Outputs whether the bot won, lost or drew.
+ * @param winner The winning player, Player::NONE for a draw.
+ */
+void Bot::handle_game_over(int winner) {
+    if (winner == Player::CLIENT) {
+        std::cout << "You won the game!" << std::endl;
+    } else if (winner == Player::NONE) {
+        std::cout << "The game is a draw!" << std::endl;
+    } else {
+        std::cout << "You lost the game!" << std::endl;
     }
+    game_over = true;
 }
 
 /**
@@ -142,12 +257,20 @@ void Bot::handle_your_turn(client* c, websocketpp::connection_hdl hdl) {
 }
 
 /**
- * @brief Sends a move to the server. Constructs a JSON message with the move information.
+ * @brief Sends a move to the server, as a binary frame or a JSON message.
  * @param c Pointer to the WebSocket client.
  * @param hdl The connection handle.
  * @param column The column number where the bot wants to place its move.
  */
 void Bot::send_move(client* c, websocketpp::connection_hdl hdl, int column) {
+    if (binary) {
+        MoveFrame move;
+        move.column = static_cast<uint8_t>(column);
+        auto bytes = encode_frame(move);
+        c->send(hdl, bytes.data(), bytes.size(), websocketpp::frame::opcode::binary);
+        return;
+    }
+
     Json::Value move;
     move["type"] = "move";
     move["column"] = column;
@@ -155,6 +278,23 @@ void Bot::send_move(client* c, websocketpp::connection_hdl hdl, int column) {
     send_json_message(c, hdl, move);
 }
 
+/**
+ * @brief Asks the server for the whole board, as a binary frame or a JSON message.
+ * @param c Pointer to the WebSocket client.
+ * @param hdl The connection handle.
+ */
+void Bot::send_board_request(client* c, websocketpp::connection_hdl hdl) {
+    if (binary) {
+        auto bytes = encode_frame(BoardRequestFrame());
+        c->send(hdl, bytes.data(), bytes.size(), websocketpp::frame::opcode::binary);
+        return;
+    }
+
+    Json::Value request;
+    request["type"] = "board_request";
+    send_json_message(c, hdl, request);
+}
+
 /**
  * @brief Sends a JSON message to the server using the WebSocket connection.
  * @param c Pointer to the WebSocket client.
@@ -162,9 +302,8 @@ void Bot::send_move(client* c, websocketpp::connection_hdl hdl, int column) {
  * @param message The JSON message to be sent.
  */
 void Bot::send_json_message(client* c, websocketpp::connection_hdl hdl, const Json::Value& message) {
-    Json::StreamWriterBuilder writer;
-    std::string message_str = Json::writeString(writer, message);
-    c->send(hdl, message_str, websocketpp::frame::opcode::text);
+    std::string_view message_str = write_compact_json(message);
+    c->send(hdl, message_str.data(), message_str.size(), websocketpp::frame::opcode::text);
 }
 
 /**
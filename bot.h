@@ -3,6 +3,7 @@
 
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
+#include "BinaryProtocol.h"
 #include <string>
 #include <mutex>
 #include <condition_variable>
@@ -23,6 +24,9 @@ typedef websocketpp::client<websocketpp::config::asio_client> client;
 /**
  * @class Bot
  * @brief A class representing a game-playing bot that connects to a server via WebSocket.
+ *
+ * The bot offers BINARY_SUBPROTOCOL when it connects and falls back to JSON messages
+ * if the server does not select it.
  */
 class Bot {
 public:
@@ -53,6 +57,14 @@ protected:
      */
     void on_message(client* c, websocketpp::connection_hdl hdl, client::message_ptr msg);
 
+    /**
+     * @brief Handles a binary frame from the server and calls the appropriate handler based on its type.
+     * @param c Pointer to the WebSocket client.
+     * @param hdl The connection handle.
+     * @param payload The frame.
+     */
+    void on_binary_message(client* c, websocketpp::connection_hdl hdl, const std::string& payload);
+
     /**
      * @brief Abstract method to get the bot's move. Must be implemented by derived classes.
      * @return The column number where the bot wants to place its move.
@@ -60,13 +72,20 @@ protected:
     virtual int get_move() = 0;
 
     /**
-     * @brief Sends a move to the server. Constructs a JSON message with the move information.
+     * @brief Sends a move to the server, as a binary frame or a JSON message.
      * @param c Pointer to the WebSocket client.
      * @param hdl The connection handle.
      * @param column The column number where the bot wants to place its move.
      */
     void send_move(client* c, websocketpp::connection_hdl hdl, int column);
 
+    /**
+     * @brief Asks the server for the whole board, as a binary frame or a JSON message.
+     * @param c Pointer to the WebSocket client.
+     * @param hdl The connection handle.
+     */
+    void send_board_request(client* c, websocketpp::connection_hdl hdl);
+
     /**
      * @brief Prints the current state of the game board to the console.
      * @param boardJson The JSON object representing the game board.
@@ -83,6 +102,9 @@ protected:
 
     std::string player_name; /**< The name of the player */
     bool last_result_valid;  /**< Indicates if the last move result was valid */
+    int columns;             /**< The number of columns on the server's board, taken from the last board received */
+    bool binary;             /**< Indicates if the server selected BINARY_SUBPROTOCOL */
+    Json::Value board;       /**< The board, rebuilt from the moves since the last board received */
 
 private:
     /**
@@ -98,6 +120,38 @@ private:
      */
     void handle_move_result(client* c, websocketpp::connection_hdl hdl, const Json::Value& root);
 
+    /**
+     * @brief Handles the binary result of a move. Applies the move or asks for another move.
+     * @param c Pointer to the WebSocket client.
+     * @param hdl The connection handle.
+     * @param result The move result frame.
+     */
+    void handle_move_result(client* c, websocketpp::connection_hdl hdl, const MoveResultFrame& result);
+
+    /**
+     * @brief Handles the end of the game. Outputs whether the bot won, lost or drew.
+     * @param winner The winning player, Player::NONE for a draw.
+     */
+    void handle_game_over(int winner);
+
+    /**
+     * @brief Applies a move to the board. Asks the server for the whole board if a move was missed.
+     * @param c Pointer to the WebSocket client.
+     * @param hdl The connection handle.
+     * @param column The column played.
+     * @param row The row the disc landed in, counted from the top.
+     * @param player The player who moved.
+     * @param move_seq The sequence number of the move.
+     */
+    void apply_move(client* c, websocketpp::connection_hdl hdl, int column, int row, int player, int move_seq);
+
+    /**
+     * @brief Replaces the board with a snapshot from the server.
+     * @param snapshot The board, row by row from the top.
+     * @param snapshot_seq The sequence number of the last move on the board.
+     */
+    void handle_board(const Json::Value& snapshot, int snapshot_seq);
+
     /**
      * @brief Handles the bot's turn to make a move. Prompts for a move and sends it to the server.
      * @param c Pointer to the WebSocket client.
@@ -111,6 +165,8 @@ private:
     bool connection_open; /**< Indicates if the connection is open */
     bool my_turn; /**< Indicates if it's the bot's turn */
     bool game_over; /**< Indicates if the game is over */
+    int seq; /**< The sequence number of the last move applied to the board */
+    bool awaiting_board; /**< Indicates if a board was requested and moves are ignored until it arrives */
 };
 
 #endif // BOT_H
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
+#include "BinaryProtocol.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
 #include <iostream>
 #include <string>
 #include <json/json.h>
@@ -21,11 +24,27 @@ struct Configuration {
     bool my_turn = false;
     bool game_over = false;
     std::string player_name;
+    int columns = 7; // Taken from the last board received
+    bool binary = false; // Whether the server selected the binary subprotocol
+    Json::Value board; // Rebuilt from the moves since the last board received
+    int seq = 0; // The sequence number of the last move applied to the board
+    bool awaiting_board = false; // Moves are ignored until a requested board arrives
 };
 
 // Create a global instance of Configuration
 Configuration config;
 
+/**
+ * @brief Sends a JSON message to the server.
+ * @param c The client instance.
+ * @param hdl The connection handle.
+ * @param message The JSON message to send.
+ */
+void send_json_message(client* c, websocketpp::connection_hdl hdl, const Json::Value& message) {
+    std::string_view message_str = write_compact_json(message);
+    c->send(hdl, message_str.data(), message_str.size(), websocketpp::frame::opcode::text);
+}
+
 /**
  * @brief Callback function for when a new connection is opened.
  * @param c The client instance.
@@ -37,6 +56,7 @@ void on_open(client* c, websocketpp::connection_hdl hdl) {
     std::lock_guard<std::mutex> lock(config.connection_mutex);
     config.connection_open = true;
     config.connection_cv.notify_one();
+    config.binary = c->get_con_from_hdl(hdl)->get_response_header("Sec-WebSocket-Protocol") == BINARY_SUBPROTOCOL;
 
     std::cout << "Connected to server. Enter your name: ";
     std::getline(std::cin, config.player_name);
@@ -46,9 +66,7 @@ void on_open(client* c, websocketpp::connection_hdl hdl) {
     name_message["type"] = "player_name";
     name_message["name"] = config.player_name;
 
-    Json::StreamWriterBuilder writer;
-    std::string name_str = Json::writeString(writer, name_message);
-    c->send(hdl, name_str, websocketpp::frame::opcode::text);
+    send_json_message(c, hdl, name_message);
 }
 
 /**
@@ -84,13 +102,81 @@ void print_board(const Json::Value& boardJson) {
  */
 void send_move(client* c, websocketpp::connection_hdl hdl, std::string column) {
     std::cout << "send_move: " << column << std::endl;
+    if (config.binary) {
+        MoveFrame move;
+        try {
+            move.column = static_cast<uint8_t>(std::stoi(column));
+        } catch (const std::exception&) {
+            move.column = UINT8_MAX; // Rejected by the server like any other invalid column
+        }
+        auto bytes = encode_frame(move);
+        c->send(hdl, bytes.data(), bytes.size(), websocketpp::frame::opcode::binary);
+        return;
+    }
+
     Json::Value move;
     move["type"] = "move";
     move["column"] = column;
+    send_json_message(c, hdl, move);
+}
+
+/**
+ * @brief Asks the server for the whole board.
+ * @param c The client instance.
+ * @param hdl The connection handle.
+ */
+void send_board_request(client* c, websocketpp::connection_hdl hdl) {
+    if (config.binary) {
+        auto bytes = encode_frame(BoardRequestFrame());
+        c->send(hdl, bytes.data(), bytes.size(), websocketpp::frame::opcode::binary);
+        return;
+    }
+
+    Json::Value request;
+    request["type"] = "board_request";
+    send_json_message(c, hdl, request);
+}
+
+/**
+ * @brief Applies a move to the board, or asks for the whole board if a move was missed.
+ * @param c The client instance.
+ * @param hdl The connection handle.
+ * @param column The column played.
+ * @param row The row the disc landed in, counted from the top.
+ * @param player The player who moved.
+ * @param seq The sequence number of the move.
+ */
+void apply_move(client* c, websocketpp::connection_hdl hdl, int column, int row, int player, int seq) {
+    if (config.awaiting_board) {
+        return; // The requested board already includes this move
+    }
+
+    if (seq != config.seq + 1 || row < 0 || row >= static_cast<int>(config.board.size()) ||
+        column < 0 || column >= static_cast<int>(config.board[row].size())) {
+        std::cout << "Missed a move. Asking the server for the board..." << std::endl;
+        config.awaiting_board = true;
+        send_board_request(c, hdl);
+        return;
+    }
+
+    config.board[row][column] = player;
+    config.seq = seq;
+    print_board(config.board);
+}
 
-    Json::StreamWriterBuilder writer;
-    std::string move_str = Json::writeString(writer, move);
-    c->send(hdl, move_str, websocketpp::frame::opcode::text);
+/**
+ * @brief Handles a board snapshot from the server.
+ * @param board The board, row by row from the top.
+ * @param seq The sequence number of the last move on the board.
+ */
+void handle_board(const Json::Value& board, int seq) {
+    config.board = board;
+    if (!board.empty()) {
+        config.columns = board[0].size();
+    }
+    config.seq = seq;
+    config.awaiting_board = false;
+    print_board(config.board);
 }
 
 /**
@@ -101,6 +187,21 @@ void handle_game_start() {
     std::cout << "Waiting for server to make a move..." << std::endl;
 }
 
+/**
+ * @brief Handles the game over event.
+ * @param winner The winning player, Player::NONE for a draw.
+ */
+void handle_game_over(int winner) {
+    if (winner == Player::CLIENT) {
+        std::cout << "You won the game!" << std::endl;
+    } else if (winner == Player::NONE) {
+        std::cout << "The game is a draw!" << std::endl;
+    } else {
+        std::cout << "You lost the game!" << std::endl;
+    }
+    config.game_over = true;
+}
+
 /**
  * @brief Handles the player's turn event.
  * @param c The client instance.
@@ -111,7 +212,7 @@ void handle_your_turn(client* c, websocketpp::connection_hdl hdl) {
     std::cout << "It's your turn!" << std::endl;
 
     std::string column;
-    std::cout << "Enter column (0-6) to drop your disc: ";
+    std::cout << "Enter column (0-" << config.columns - 1 << ") to drop your disc: ";
     std::cin >> column;
     send_move(c, hdl, column);
 
@@ -133,18 +234,52 @@ void handle_move_result(client* c, websocketpp::connection_hdl hdl, const Json::
         return;
     }
 
-    if (root.isMember("board")) {
-        print_board(root["board"]);
-    }
+    apply_move(c, hdl, root["column"].asInt(), root["row"].asInt(), root["player"].asInt(), root["seq"].asInt());
 
     bool win = root["win"].asBool();
     if (win) {
-        if (root["winner"].asInt() == Player::CLIENT) {
-            std::cout << "You won the game!" << std::endl;
+        handle_game_over(root["winner"].asInt());
+    }
+}
+
+/**
+ * @brief Handles a binary frame.
+ * @param c The client instance.
+ * @param hdl The connection handle.
+ * @param payload The frame received.
+ */
+void on_binary_message(client* c, websocketpp::connection_hdl hdl, const std::string& payload) {
+    GameStartFrame start;
+    BoardFrame snapshot;
+    MoveResultFrame result;
+    GameOverFrame over;
+    if (decode_frame(payload, start)) {
+        config.columns = start.columns;
+        handle_game_start();
+    } else if (decode_frame(payload, snapshot)) {
+        Json::Value board(Json::arrayValue);
+        for (int row = 0; row < snapshot.rows; ++row) {
+            Json::Value row_json(Json::arrayValue);
+            for (int column = 0; column < snapshot.columns; ++column) {
+                row_json.append(snapshot.cells[row * snapshot.columns + column]);
+            }
+            board.append(row_json);
+        }
+        handle_board(board, snapshot.seq);
+    } else if (decode_frame(payload, result)) {
+        if (result.status != MoveStatus::PLAYED) {
+            std::cout << "Error: Invalid move. Please try a different column." << std::endl;
+            config.my_turn = true;
+            handle_your_turn(c, hdl);
         } else {
-            std::cout << "You lost the game!" << std::endl;
+            apply_move(c, hdl, result.column, result.row, result.player, result.seq);
         }
-        config.game_over = true;
+    } else if (frame_type(payload) == FrameType::YOUR_TURN) {
+        handle_your_turn(c, hdl);
+    } else if (decode_frame(payload, over)) {
+        handle_game_over(over.winner);
+    } else {
+        std::cerr << "Failed to parse binary frame." << std::endl;
     }
 }
 
@@ -155,11 +290,14 @@ void handle_move_result(client* c, websocketpp::connection_hdl hdl, const Json::
  * @param msg The message received.
  */
 void on_message(client* c, websocketpp::connection_hdl hdl, client::message_ptr msg) {
+    if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+        on_binary_message(c, hdl, msg->get_payload());
+        return;
+    }
+
     Json::Value root;
-    Json::CharReaderBuilder reader;
     std::string errs;
-    std::istringstream stream(msg->get_payload());
-    if (!Json::parseFromStream(reader, stream, &root, &errs)) {
+    if (!parse_json(msg->get_payload(), root, &errs)) {
         std::cerr << "Failed to parse message: " << errs << std::endl;
         return;
     }
@@ -169,8 +307,12 @@ void on_message(client* c, websocketpp::connection_hdl hdl, client::message_ptr
         handle_game_start();
     } else if (message_type == "move_result") {
         handle_move_result(c, hdl, root);
+    } else if (message_type == "board") {
+        handle_board(root["board"], root["seq"].asInt());
     } else if (message_type == "your_turn") {
         handle_your_turn(c, hdl);
+    } else if (message_type == "game_over") {
+        handle_game_over(root["winner"].asInt());
     }
 }
 
@@ -204,6 +346,7 @@ int main(int argc, char* argv[]) {
         std::cerr << "Could not create connection because: " << ec.message() << std::endl;
         return 1; // Exit if connection cannot be established
     }
+    con->add_subprotocol(BINARY_SUBPROTOCOL); // Falls back to JSON if the server does not select it
 
     std::cout << "Looking for server..." << std::endl;
 
@@ -0,0 +1,119 @@
+#include "DatabaseManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Runs the mixed load: reader threads look ratings up as players connect while
+ *        writer threads record game results, for a fixed time.
+ * @param config The database settings under test. The database file is recreated.
+ * @param players The number of distinct players.
+ * @param readers The number of threads looking ratings up.
+ * @param writers The number of threads recording results.
+ * @param seconds How long the load runs.
+ * @param reads_per_second Receives the number of lookups per second.
+ * @param writes_per_second Receives the number of committed updates per second.
+ */
+void run_load(const DatabaseConfig& config, int players, int readers, int writers, double seconds,
+              double& reads_per_second, double& writes_per_second) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::remove((config.path + suffix).c_str());
+    }
+
+    DatabaseManager db_manager(config);
+    for (int i = 0; i < players; ++i) {
+        db_manager.update_or_insert_player_elo("player" + std::to_string(i), 0);
+    }
+    db_manager.flush();
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> writes{0};
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < readers + writers; ++t) {
+        bool writer = t >= readers;
+        threads.emplace_back([&, writer, t]() {
+            std::mt19937 gen(t + 1);
+            std::uniform_int_distribution<int> pick(0, players - 1);
+            uint64_t count = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                std::string name = "player" + std::to_string(pick(gen));
+                if (writer) {
+                    db_manager.update_or_insert_player_elo(name, (count & 1) ? 1 : -1);
+                } else {
+                    db_manager.get_player_elo(name);
+                }
+                ++count;
+            }
+            (writer ? writes : reads) += count;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double read_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Updates only count once they are committed.
+    db_manager.flush();
+    double write_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    reads_per_second = reads / read_seconds;
+    writes_per_second = writes / write_seconds;
+}
+
+/**
+ * @brief Main function of the database benchmark.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments: the optional number of reader threads (4), writer threads (2)
+ *             and seconds per run (3).
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int readers = argc > 1 ? std::atoi(argv[1]) : 4;
+    int writers = argc > 2 ? std::atoi(argv[2]) : 2;
+    double seconds = argc > 3 ? std::atof(argv[3]) : 3.0;
+    constexpr int players = 10000;
+
+    // The settings DatabaseManager used before WAL and the read connections.
+    DatabaseConfig rollback;
+    rollback.path = "db_bench_rollback.db";
+    rollback.journal_mode = "DELETE";
+    rollback.synchronous = "FULL";
+    rollback.cache_size_kb = 2000;
+    rollback.mmap_size_mb = 0;
+    rollback.read_connections = 1;
+    rollback.player_cache_size = 0;
+
+    DatabaseConfig wal;
+    wal.path = "db_bench_wal.db";
+    wal.player_cache_size = 0;
+
+    DatabaseConfig cached;
+    cached.path = "db_bench_cached.db";
+
+    std::cout << players << " players, " << readers << " reader threads, " << writers << " writer threads, "
+              << seconds << " s per run" << std::endl;
+    std::cout << "setup                 reads/s    writes/s" << std::endl;
+    for (const auto& [label, config] : {std::pair<const char*, DatabaseConfig>{"rollback, FULL, 1 conn", rollback},
+                                        std::pair<const char*, DatabaseConfig>{"WAL, NORMAL, pool    ", wal},
+                                        std::pair<const char*, DatabaseConfig>{"WAL + player cache    ", cached}}) {
+        double reads_per_second;
+        double writes_per_second;
+        run_load(config, players, readers, writers, seconds, reads_per_second, writes_per_second);
+        std::cout << label << "  " << static_cast<uint64_t>(reads_per_second) << "\t    "
+                  << static_cast<uint64_t>(writes_per_second) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "ConnectFourGame.h"
+#include "DatabaseManager.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Main function of the game replay tool. Prints an archived game move by move.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments: the game id and the optional database path.
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <game_id> [database]" << std::endl;
+        return 1;
+    }
+
+    DatabaseConfig database;
+    if (argc > 2) {
+        database.path = argv[2];
+    }
+    // Replaying never writes, so the database must already exist and no writer is started.
+    database.read_only = true;
+    database.read_connections = 1;
+    DatabaseManager db_manager(database);
+    if (!db_manager.is_open()) {
+        std::cerr << "Cannot open " << database.path << std::endl;
+        return 1;
+    }
+
+    GameRecord record;
+    if (!db_manager.load_game(std::atoll(argv[1]), record)) {
+        std::cerr << "No game " << argv[1] << " in " << database.path << std::endl;
+        return 1;
+    }
+    std::cout << record.player << " vs " << record.opponent << ", score " << record.score << ", "
+              << record.rows << "x" << record.columns << " with " << record.win_condition << " in a row, "
+              << record.move_count << " moves, " << (record.played_at - record.started_at) << " s" << std::endl;
+
+    bool supported = dispatch_game_variant(record.rows, record.columns, record.win_condition, [&](auto variant) {
+        using Game = typename decltype(variant)::type;
+        Game game;
+        // The opponent always moves first.
+        Player player = Player::SERVER;
+        for (uint8_t column : record.unpack_moves()) {
+            std::cout << (player == Player::SERVER ? record.opponent : record.player) << " plays " << static_cast<int>(column) << std::endl;
+            if (!game.make_move(player, column)) {
+                std::cerr << "Illegal move in the archive." << std::endl;
+                break;
+            }
+            player = player == Player::SERVER ? Player::CLIENT : Player::SERVER;
+        }
+        game.print_board();
+    });
+
+    if (!supported) {
+        std::cerr << "Unsupported board: " << record.rows << "x" << record.columns << " with " << record.win_condition << " in a row." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -240,6 +240,85 @@ private:
   bool collectComments_{};
 }; // Reader
 
+/** \brief Receives the events of an event-driven (SAX-style) parse.
+ *
+ * CharReader::parseEvents() walks the document with the same tokenizer as
+ * the Value-building parse, but calls one method per token instead of
+ * building a tree. Every method returns true to continue, or false to stop
+ * reading once the handler has what it needs; stopping is not an error, so
+ * parseEvents() still returns true. The defaults do nothing and continue, so
+ * a handler only overrides the events it needs.
+ *
+ * Usage:
+ *   \code
+ *   struct MoveHandler : Json::ParseHandler {
+ *     bool inColumn = false;
+ *     int column = -1;
+ *     bool onKey(char const* begin, char const* end) override {
+ *       inColumn = Json::String(begin, end) == "column";
+ *       return true;
+ *     }
+ *     bool onNumber(Json::Value const& value) override {
+ *       if (inColumn)
+ *         column = value.asInt();
+ *       return !inColumn; // Stop once the column is known.
+ *     }
+ *   };
+ *   \endcode
+ */
+class JSON_API ParseHandler {
+public:
+  virtual ~ParseHandler() = default;
+
+  /// Called on '{'.
+  virtual bool onObjectBegin() { return true; }
+  /// Called on '}'.
+  virtual bool onObjectEnd() { return true; }
+  /// Called on '['.
+  virtual bool onArrayBegin() { return true; }
+  /// Called on ']'.
+  virtual bool onArrayEnd() { return true; }
+
+  /** \brief Called on the name of an object member, before its value.
+   * \param begin The first character of the decoded name.
+   * \param end   One past the last character. The range is only valid during
+   *              the call; it points into the document when the name has no
+   *              escape sequences, and into a reused buffer otherwise.
+   */
+  virtual bool onKey(char const* begin, char const* end) {
+    (void)begin;
+    (void)end;
+    return true;
+  }
+
+  /** \brief Called on a string value.
+   * \param begin The first character of the decoded string.
+   * \param end   One past the last character, valid as for onKey().
+   */
+  virtual bool onString(char const* begin, char const* end) {
+    (void)begin;
+    (void)end;
+    return true;
+  }
+
+  /** \brief Called on a number, including special floats if they are allowed.
+   * \param value An intValue, uintValue or realValue holding the number.
+   */
+  virtual bool onNumber(Value const& value) {
+    (void)value;
+    return true;
+  }
+
+  /// Called on true and false.
+  virtual bool onBool(bool value) {
+    (void)value;
+    return true;
+  }
+
+  /// Called on null, and on dropped null placeholders if they are allowed.
+  virtual bool onNull() { return true; }
+};
+
 /** Interface for reading JSON from a char array.
  */
 class JSON_API CharReader {
@@ -270,6 +349,24 @@ public:
   virtual bool parse(char const* beginDoc, char const* endDoc, Value* root,
                      String* errs);
 
+  /** \brief Read a <a HREF="http://www.json.org">JSON</a> document as a
+   * sequence of events, without building a Value.
+   *
+   * The settings of the builder apply as for the Value-building parse, except
+   * that `"rejectDupKeys"` is not checked and comments are never collected.
+   *
+   * \param      beginDoc Pointer on the beginning of the UTF-8 encoded string
+   *                      of the document to read.
+   * \param      endDoc   Pointer on the end of the UTF-8 encoded string of the
+   *                      document to read. Must be >= beginDoc.
+   * \param      handler  Receives the events, in document order.
+   * \param[out] errs     Formatted error messages (if not NULL).
+   * \return \c true if the document was read, or the handler stopped reading
+   * before an error was found; \c false if an error occurred.
+   */
+  bool parseEvents(char const* beginDoc, char const* endDoc,
+                   ParseHandler& handler, String* errs);
+
   /** \brief Returns a vector of structured errors encountered while parsing.
    * Each parse call resets the stored list of errors.
    */
@@ -290,6 +387,8 @@ protected:
     virtual ~Impl() = default;
     virtual bool parse(char const* beginDoc, char const* endDoc, Value* root,
                        String* errs) = 0;
+    virtual bool parseEvents(char const* beginDoc, char const* endDoc,
+                             ParseHandler& handler, String* errs);
     virtual std::vector<StructuredError> getStructuredErrors() const = 0;
   };
 
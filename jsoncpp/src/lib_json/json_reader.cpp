@@ -881,6 +881,8 @@ public:
   explicit OurReader(OurFeatures const& features);
   bool parse(const char* beginDoc, const char* endDoc, Value& root,
              bool collectComments = true);
+  bool parseEvents(const char* beginDoc, const char* endDoc,
+                   ParseHandler& handler);
   String getFormattedErrorMessages() const;
   std::vector<CharReader::StructuredError> getStructuredErrors() const;
 
@@ -938,6 +940,11 @@ private:
   bool readValue();
   bool readObject(Token& token);
   bool readArray(Token& token);
+  bool readValueEvents(ParseHandler& handler, size_t depth);
+  bool readObjectEvents(ParseHandler& handler, size_t depth);
+  bool readArrayEvents(ParseHandler& handler, size_t depth);
+  bool decodeStringEvent(Token& token, Location& begin, Location& end);
+  bool stopByHandler();
   bool decodeNumber(Token& token);
   bool decodeNumber(Token& token, Value& decoded);
   bool decodeString(Token& token);
@@ -975,6 +982,8 @@ private:
   Value* lastValue_ = nullptr;
   bool lastValueHasAComment_ = false;
   String commentsBefore_{};
+  String scratch_{};
+  bool stopped_ = false;
 
   OurFeatures const features_;
   bool collectComments_ = false;
@@ -1035,6 +1044,204 @@ bool OurReader::parse(const char* beginDoc, const char* endDoc, Value& root,
   return successful;
 }
 
+bool OurReader::parseEvents(const char* beginDoc, const char* endDoc,
+                            ParseHandler& handler) {
+  begin_ = beginDoc;
+  end_ = endDoc;
+  collectComments_ = false;
+  current_ = begin_;
+  lastValueEnd_ = nullptr;
+  lastValue_ = nullptr;
+  commentsBefore_.clear();
+  errors_.clear();
+  stopped_ = false;
+
+  // skip byte order mark if it exists at the beginning of the UTF-8 text.
+  skipBom(features_.skipBom_);
+  if (!readValueEvents(handler, 0))
+    return stopped_;
+  Token token;
+  readTokenSkippingComments(token);
+  if (features_.failIfExtra_ && (token.type_ != tokenEndOfStream)) {
+    addError("Extra non-whitespace after JSON value.", token);
+    return false;
+  }
+  return true;
+}
+
+bool OurReader::readValueEvents(ParseHandler& handler, size_t depth) {
+  // Same limit as readValue(), where the root is the first node.
+  if (depth >= features_.stackLimit_)
+    throwRuntimeError("Exceeded stackLimit in readValue().");
+  Token token;
+  readTokenSkippingComments(token);
+
+  // The tree parser checks the root once it is built; here it must be checked
+  // before any event reaches the handler.
+  if (depth == 0 && features_.strictRoot_ &&
+      token.type_ != tokenObjectBegin && token.type_ != tokenArrayBegin) {
+    token.type_ = tokenError;
+    token.start_ = begin_;
+    token.end_ = end_;
+    return addError(
+        "A valid JSON document must be either an array or an object value.",
+        token);
+  }
+
+  bool proceed = true;
+  switch (token.type_) {
+  case tokenObjectBegin:
+    if (!handler.onObjectBegin())
+      return stopByHandler();
+    return readObjectEvents(handler, depth);
+  case tokenArrayBegin:
+    if (!handler.onArrayBegin())
+      return stopByHandler();
+    return readArrayEvents(handler, depth);
+  case tokenNumber: {
+    Value decoded;
+    if (!decodeNumber(token, decoded))
+      return false;
+    proceed = handler.onNumber(decoded);
+  } break;
+  case tokenString: {
+    Location begin;
+    Location end;
+    if (!decodeStringEvent(token, begin, end))
+      return false;
+    proceed = handler.onString(begin, end);
+  } break;
+  case tokenTrue:
+    proceed = handler.onBool(true);
+    break;
+  case tokenFalse:
+    proceed = handler.onBool(false);
+    break;
+  case tokenNull:
+    proceed = handler.onNull();
+    break;
+  case tokenNaN:
+    proceed = handler.onNumber(Value(std::numeric_limits<double>::quiet_NaN()));
+    break;
+  case tokenPosInf:
+    proceed = handler.onNumber(Value(std::numeric_limits<double>::infinity()));
+    break;
+  case tokenNegInf:
+    proceed = handler.onNumber(Value(-std::numeric_limits<double>::infinity()));
+    break;
+  case tokenArraySeparator:
+  case tokenObjectEnd:
+  case tokenArrayEnd:
+    if (features_.allowDroppedNullPlaceholders_) {
+      // "Un-read" the current token and report a null.
+      current_--;
+      proceed = handler.onNull();
+      break;
+    } // else, fall through ...
+  default:
+    return addError("Syntax error: value, object or array expected.", token);
+  }
+  return proceed || stopByHandler();
+}
+
+bool OurReader::readObjectEvents(ParseHandler& handler, size_t depth) {
+  Token tokenName;
+  bool first = true;
+  while (readTokenSkippingComments(tokenName)) {
+    if (tokenName.type_ == tokenObjectEnd &&
+        (first || features_.allowTrailingCommas_)) { // empty object or
+                                                     // trailing comma
+      return handler.onObjectEnd() || stopByHandler();
+    }
+    first = false;
+    Location begin;
+    Location end;
+    if (tokenName.type_ == tokenString) {
+      if (!decodeStringEvent(tokenName, begin, end))
+        return false;
+    } else if (tokenName.type_ == tokenNumber && features_.allowNumericKeys_) {
+      Value numberName;
+      if (!decodeNumber(tokenName, numberName))
+        return false;
+      scratch_ = numberName.asString();
+      begin = scratch_.data();
+      end = begin + scratch_.size();
+    } else {
+      break;
+    }
+    if (end - begin >= (1 << 30))
+      throwRuntimeError("keylength >= 2^30");
+
+    Token colon;
+    if (!readToken(colon) || colon.type_ != tokenMemberSeparator)
+      return addError("Missing ':' after object member name", colon);
+    if (!handler.onKey(begin, end))
+      return stopByHandler();
+    if (!readValueEvents(handler, depth + 1))
+      return false;
+
+    Token comma;
+    if (!readTokenSkippingComments(comma) ||
+        (comma.type_ != tokenObjectEnd && comma.type_ != tokenArraySeparator))
+      return addError("Missing ',' or '}' in object declaration", comma);
+    if (comma.type_ == tokenObjectEnd)
+      return handler.onObjectEnd() || stopByHandler();
+  }
+  return addError("Missing '}' or object member name", tokenName);
+}
+
+bool OurReader::readArrayEvents(ParseHandler& handler, size_t depth) {
+  int index = 0;
+  for (;;) {
+    skipSpaces();
+    if (current_ != end_ && *current_ == ']' &&
+        (index == 0 ||
+         (features_.allowTrailingCommas_ &&
+          !features_.allowDroppedNullPlaceholders_))) // empty array or trailing
+                                                      // comma
+    {
+      Token endArray;
+      readToken(endArray);
+      return handler.onArrayEnd() || stopByHandler();
+    }
+    ++index;
+    if (!readValueEvents(handler, depth + 1))
+      return false;
+
+    Token currentToken;
+    // Accept Comment after last item in the array.
+    bool ok = readTokenSkippingComments(currentToken);
+    bool badTokenType = (currentToken.type_ != tokenArraySeparator &&
+                         currentToken.type_ != tokenArrayEnd);
+    if (!ok || badTokenType)
+      return addError("Missing ',' or ']' in array declaration", currentToken);
+    if (currentToken.type_ == tokenArrayEnd)
+      return handler.onArrayEnd() || stopByHandler();
+  }
+}
+
+bool OurReader::decodeStringEvent(Token& token, Location& begin,
+                                  Location& end) {
+  begin = token.start_ + 1; // skip '"'
+  end = token.end_ - 1;     // do not include '"'
+  // Without escapes (or a '"' inside single quotes, where decodeString()
+  // stops) the decoded string is the document itself.
+  if (std::none_of(begin, end, [](char c) { return c == '\\' || c == '"'; }))
+    return true;
+  scratch_.clear();
+  if (!decodeString(token, scratch_))
+    return false;
+  begin = scratch_.data();
+  end = begin + scratch_.size();
+  return true;
+}
+
+bool OurReader::stopByHandler() {
+  // Unwinds like an error, but parseEvents() reports success.
+  stopped_ = true;
+  return false;
+}
+
 bool OurReader::readValue() {
   //  To preserve the old behaviour we cast size_t to int.
   if (nodes_.size() > features_.stackLimit_)
@@ -1864,6 +2071,15 @@ protected:
       return ok;
     }
 
+    bool parseEvents(char const* beginDoc, char const* endDoc,
+                     ParseHandler& handler, String* errs) override {
+      bool ok = reader_.parseEvents(beginDoc, endDoc, handler);
+      if (errs) {
+        *errs = reader_.getFormattedErrorMessages();
+      }
+      return ok;
+    }
+
     std::vector<CharReader::StructuredError>
     getStructuredErrors() const override {
       return reader_.getStructuredErrors();
@@ -1988,6 +2204,19 @@ bool CharReader::parse(char const* beginDoc, char const* endDoc, Value* root,
   return _impl->parse(beginDoc, endDoc, root, errs);
 }
 
+bool CharReader::parseEvents(char const* beginDoc, char const* endDoc,
+                             ParseHandler& handler, String* errs) {
+  return _impl->parseEvents(beginDoc, endDoc, handler, errs);
+}
+
+bool CharReader::Impl::parseEvents(char const* /*beginDoc*/,
+                                   char const* /*endDoc*/,
+                                   ParseHandler& /*handler*/, String* errs) {
+  if (errs)
+    *errs = "Event-driven parsing is not supported by this reader.\n";
+  return false;
+}
+
 //////////////////////////////////
 // global functions
 
@@ -3266,6 +3266,160 @@ JSONTEST_FIXTURE_LOCAL(CharReaderTest, testOperator) {
   JSONTEST_ASSERT_EQUAL("value", root["property"]);
 }
 
+struct CharReaderEventTest : JsonTest::TestCase {
+  // Records every event as one line of text.
+  struct Recorder : Json::ParseHandler {
+    Json::String events;
+    bool onObjectBegin() override { return add("{"); }
+    bool onObjectEnd() override { return add("}"); }
+    bool onArrayBegin() override { return add("["); }
+    bool onArrayEnd() override { return add("]"); }
+    bool onKey(char const* begin, char const* end) override {
+      return add("key " + Json::String(begin, end));
+    }
+    bool onString(char const* begin, char const* end) override {
+      return add("string " + Json::String(begin, end));
+    }
+    bool onNumber(Json::Value const& value) override {
+      return add("number " + value.asString());
+    }
+    bool onBool(bool value) override {
+      return add(value ? "true" : "false");
+    }
+    bool onNull() override { return add("null"); }
+    bool add(Json::String const& event) {
+      events += event + "\n";
+      return true;
+    }
+  };
+
+  // Pulls two members out of a message and stops as soon as it has both.
+  struct MoveHandler : Json::ParseHandler {
+    Json::String key;
+    Json::String type;
+    int column = -1;
+    int events = 0;
+    bool onKey(char const* begin, char const* end) override {
+      ++events;
+      key.assign(begin, end);
+      return true;
+    }
+    bool onString(char const* begin, char const* end) override {
+      ++events;
+      if (key == "type")
+        type.assign(begin, end);
+      return !done();
+    }
+    bool onNumber(Json::Value const& value) override {
+      ++events;
+      if (key == "column")
+        column = value.asInt();
+      return !done();
+    }
+    bool done() const { return !type.empty() && column >= 0; }
+  };
+};
+
+JSONTEST_FIXTURE_LOCAL(CharReaderEventTest, parseEvents) {
+  Json::CharReaderBuilder b;
+  CharReaderPtr reader(b.newCharReader());
+  Json::String errs;
+  Recorder recorder;
+  char const doc[] = R"({ "a" : [1, -2, 2.5, "x"], "b" : { "c" : true },)"
+                     R"( "d" : false, "e" : null, "f" : [], "g" : {} })";
+  bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+  JSONTEST_ASSERT(ok);
+  JSONTEST_ASSERT(errs.empty());
+  JSONTEST_ASSERT_STRING_EQUAL("{\nkey a\n[\nnumber 1\nnumber -2\n"
+                               "number 2.5\nstring x\n]\nkey b\n{\nkey c\n"
+                               "true\n}\nkey d\nfalse\nkey e\nnull\nkey f\n"
+                               "[\n]\nkey g\n{\n}\n}\n",
+                               recorder.events);
+}
+
+JSONTEST_FIXTURE_LOCAL(CharReaderEventTest, parseEscapedStrings) {
+  Json::CharReaderBuilder b;
+  CharReaderPtr reader(b.newCharReader());
+  Json::String errs;
+  Recorder recorder;
+  char const doc[] = R"({ "k\"ey" : "v\nalé", "plain" : "" })";
+  bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+  JSONTEST_ASSERT(ok);
+  JSONTEST_ASSERT(errs.empty());
+  JSONTEST_ASSERT_STRING_EQUAL("{\nkey k\"ey\nstring v\nal\xc3\xa9\n"
+                               "key plain\nstring \n}\n",
+                               recorder.events);
+}
+
+JSONTEST_FIXTURE_LOCAL(CharReaderEventTest, stopEarly) {
+  Json::CharReaderBuilder b;
+  CharReaderPtr reader(b.newCharReader());
+  Json::String errs;
+  MoveHandler handler;
+  char const doc[] =
+      R"({ "type" : "move", "column" : 3, "rest" : [1, 2, 3], "bad" : )";
+  // Stopping is not an error, even though the rest of the document is not
+  // valid.
+  bool ok = reader->parseEvents(doc, doc + std::strlen(doc), handler, &errs);
+  JSONTEST_ASSERT(ok);
+  JSONTEST_ASSERT(errs.empty());
+  JSONTEST_ASSERT(reader->getStructuredErrors().empty());
+  JSONTEST_ASSERT_STRING_EQUAL("move", handler.type);
+  JSONTEST_ASSERT_EQUAL(3, handler.column);
+  JSONTEST_ASSERT_EQUAL(4, handler.events);
+}
+
+JSONTEST_FIXTURE_LOCAL(CharReaderEventTest, parseWithErrors) {
+  Json::CharReaderBuilder b;
+  CharReaderPtr reader(b.newCharReader());
+  {
+    Json::String errs;
+    Recorder recorder;
+    char const doc[] = R"({ "property" : "v\alue" })";
+    bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+    JSONTEST_ASSERT(!ok);
+    JSONTEST_ASSERT(errs ==
+                    "* Line 1, Column 16\n  Bad escape sequence in string\n"
+                    "See Line 1, Column 20 for detail.\n");
+    JSONTEST_ASSERT_STRING_EQUAL("{\nkey property\n", recorder.events);
+  }
+  {
+    Json::String errs;
+    Recorder recorder;
+    char const doc[] = "[1, 2";
+    bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+    JSONTEST_ASSERT(!ok);
+    JSONTEST_ASSERT_STRING_EQUAL("* Line 1, Column 6\n"
+                                 "  Missing ',' or ']' in array declaration\n",
+                                 errs);
+    JSONTEST_ASSERT_STRING_EQUAL("[\nnumber 1\nnumber 2\n", recorder.events);
+  }
+}
+
+JSONTEST_FIXTURE_LOCAL(CharReaderEventTest, strictMode) {
+  Json::CharReaderBuilder b;
+  b.strictMode(&b.settings_);
+  CharReaderPtr reader(b.newCharReader());
+  {
+    Json::String errs;
+    Recorder recorder;
+    char const doc[] = "\"value\"";
+    bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+    JSONTEST_ASSERT(!ok);
+    JSONTEST_ASSERT(recorder.events.empty());
+  }
+  {
+    Json::String errs;
+    Recorder recorder;
+    char const doc[] = "[] 1";
+    bool ok = reader->parseEvents(doc, doc + std::strlen(doc), recorder, &errs);
+    JSONTEST_ASSERT(!ok);
+    JSONTEST_ASSERT_STRING_EQUAL("* Line 1, Column 4\n"
+                                 "  Extra non-whitespace after JSON value.\n",
+                                 errs);
+  }
+}
+
 struct CharReaderStrictModeTest : JsonTest::TestCase {};
 
 JSONTEST_FIXTURE_LOCAL(CharReaderStrictModeTest, dupKeys) {
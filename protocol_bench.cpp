@@ -0,0 +1,192 @@
+#include "BinaryProtocol.h"
+#include "ConnectFourGame.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using Game = StandardConnectFour;
+
+/**
+ * @struct BenchMove
+ * @brief A move of a random game together with the position after it.
+ */
+struct BenchMove {
+    Game game; /**< The position after the move. */
+    Player player; /**< The player who moved. */
+    int column; /**< The column played. */
+};
+
+/**
+ * @brief Plays random games and keeps every move along the way.
+ * @param count The number of moves to generate.
+ * @return The generated moves.
+ */
+static std::vector<BenchMove> generate_moves(size_t count) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> dis(0, Game::COLUMNS - 1);
+    std::vector<BenchMove> moves;
+
+    while (moves.size() < count) {
+        Game game;
+        Player player = Player::SERVER;
+        while (!game.is_full() && moves.size() < count) {
+            int column = dis(gen);
+            if (!game.make_move(player, column))
+                continue;
+            moves.push_back({game, player, column});
+            if (game.check_winner(player))
+                break;
+            player = player == Player::SERVER ? Player::CLIENT : Player::SERVER;
+        }
+    }
+    return moves;
+}
+
+/**
+ * @struct MoveEventHandler
+ * @brief Pulls the type and the column out of a move message through the event API of the reader.
+ */
+struct MoveEventHandler : Json::ParseHandler {
+    std::string key; /**< The name of the member being read. */
+    bool is_move = false; /**< Whether the type member is "move". */
+    int column = -1; /**< The column member, -1 until it is read. */
+
+    bool onKey(const char* begin, const char* end) override {
+        key.assign(begin, end);
+        return true;
+    }
+
+    bool onString(const char* begin, const char* end) override {
+        if (key == "type") {
+            is_move = std::string_view(begin, end - begin) == "move";
+        }
+        return true;
+    }
+
+    bool onNumber(const Json::Value& value) override {
+        if (key == "column") {
+            column = value.asInt();
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Times one way of handling every move and prints the cost per message.
+ * @param name The name printed in the report.
+ * @param moves The benchmark moves.
+ * @param handle Handles one move and returns the number of bytes on the wire.
+ * @return The total number of bytes, to keep the work observable.
+ */
+template <typename Handle>
+static size_t run(const char* name, const std::vector<BenchMove>& moves, Handle handle) {
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& move : moves) {
+        bytes += handle(move);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << double(bytes) / moves.size() << " bytes, " << elapsed / moves.size() << " ns/message" << std::endl;
+    return bytes;
+}
+
+/**
+ * @brief Compares the cost of a move in the JSON and the binary protocol, in both directions.
+ * @return Exit status of the program.
+ */
+int main() {
+    std::vector<BenchMove> moves = generate_moves(200000);
+
+    run("board snapshot JSON      ", moves, [](const BenchMove& move) {
+        Json::Value response;
+        response["type"] = "board";
+        response["seq"] = move.game.move_count();
+        response["board"] = move.game.get_board_json();
+        return write_compact_json(response).size();
+    });
+    auto move_result_json = [](const BenchMove& move) {
+        Json::Value response;
+        response["type"] = "move_result";
+        response["column"] = move.column;
+        response["row"] = Game::ROWS - move.game.column_height(move.column);
+        response["player"] = move.player;
+        response["seq"] = move.game.move_count();
+        response["win"] = false;
+        response["winner"] = Player::NONE;
+        return response;
+    };
+    run("move_result JSON, builder", moves, [&](const BenchMove& move) {
+        return Json::writeString(Json::StreamWriterBuilder(), move_result_json(move)).size();
+    });
+    run("move_result JSON         ", moves, [&](const BenchMove& move) {
+        return write_compact_json(move_result_json(move)).size();
+    });
+    run("move_result binary       ", moves, [](const BenchMove& move) {
+        MoveResultFrame result;
+        result.column = static_cast<uint8_t>(move.column);
+        result.row = static_cast<uint8_t>(Game::ROWS - move.game.column_height(move.column));
+        result.player = static_cast<uint8_t>(move.player);
+        result.seq = static_cast<uint16_t>(move.game.move_count());
+        auto bytes = encode_frame(result);
+        return bytes[2] == move.column ? bytes.size() : 0;
+    });
+
+    std::vector<std::string> json_moves;
+    std::vector<std::string> binary_moves;
+    for (int column = 0; column < Game::COLUMNS; ++column) {
+        Json::Value move;
+        move["type"] = "move";
+        move["column"] = column;
+        json_moves.emplace_back(write_compact_json(move));
+        MoveFrame frame;
+        frame.column = static_cast<uint8_t>(column);
+        auto bytes = encode_frame(frame);
+        binary_moves.emplace_back(bytes.begin(), bytes.end());
+    }
+
+    size_t stream = run("move JSON, istringstream ", moves, [&](const BenchMove& move) {
+        const std::string& payload = json_moves[move.column];
+        Json::Value root;
+        Json::CharReaderBuilder reader;
+        std::string errs;
+        std::istringstream stream(payload);
+        Json::parseFromStream(reader, stream, &root, &errs);
+        return root["column"].asInt() == move.column ? payload.size() : 0;
+    });
+    size_t json = run("move JSON, CharReader    ", moves, [&](const BenchMove& move) {
+        const std::string& payload = json_moves[move.column];
+        Json::Value root;
+        parse_json(payload, root, nullptr);
+        return root["column"].asInt() == move.column ? payload.size() : 0;
+    });
+    std::unique_ptr<Json::CharReader> event_reader(Json::CharReaderBuilder().newCharReader());
+    size_t events = run("move JSON, events        ", moves, [&](const BenchMove& move) {
+        const std::string& payload = json_moves[move.column];
+        MoveEventHandler handler;
+        bool ok = event_reader->parseEvents(payload.data(), payload.data() + payload.size(), handler, nullptr);
+        return ok && handler.is_move && handler.column == move.column ? payload.size() : 0;
+    });
+    size_t fast = run("move JSON, fast path     ", moves, [&](const BenchMove& move) {
+        const std::string& payload = json_moves[move.column];
+        int column;
+        return parse_move_message(payload, column) && column == move.column ? payload.size() : 0;
+    });
+    size_t binary = run("move binary              ", moves, [&](const BenchMove& move) {
+        const std::string& payload = binary_moves[move.column];
+        MoveFrame frame;
+        return decode_frame(payload, frame) && frame.column == move.column ? payload.size() : 0;
+    });
+
+    if (stream != json || events != json || fast != json || binary != moves.size() * MoveFrame::SIZE) {
+        std::cerr << "A decoded move does not match the move sent." << std::endl;
+        return 1;
+    }
+    return 0;
+}
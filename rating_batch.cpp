@@ -0,0 +1,40 @@
+#include "RatingEngine.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Main function of the rating recomputation job. Rates every game in the database
+ *        with Glicko-2, period by period, and stores the new ratings.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments: the optional database path, number of threads,
+ *             period length in days and tau.
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    DatabaseConfig database;
+    RatingConfig rating;
+    rating.system = "glicko2";
+    if (argc > 1) {
+        database.path = argv[1];
+    }
+    if (argc > 2) {
+        rating.threads = std::atoi(argv[2]);
+    }
+    if (argc > 3) {
+        rating.period_days = std::atoi(argv[3]);
+    }
+    if (argc > 4) {
+        rating.tau = std::atof(argv[4]);
+    }
+
+    DatabaseManager db_manager(database);
+    RatingEngine engine(db_manager, rating);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t games = engine.recompute();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Rated " << games << " games in " << seconds << " s." << std::endl;
+    return 0;
+}
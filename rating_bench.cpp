@@ -0,0 +1,54 @@
+#include "RatingEngine.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Main function of the Glicko-2 recomputation benchmark. Rates synthetic games
+ *        between players of hidden strength, split into periods, with 1 to 16 threads.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments: the optional number of games (2000000), players (100000)
+ *             and periods (52).
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    size_t game_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    uint32_t players = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 100000;
+    size_t periods = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 52;
+
+    std::mt19937_64 gen(1);
+    std::normal_distribution<double> talent(100, 200);
+    std::vector<double> strength(players);
+    for (double& s : strength) {
+        s = talent(gen);
+    }
+    std::uniform_int_distribution<uint32_t> pick(0, players - 1);
+    std::uniform_real_distribution<double> coin(0, 1);
+    std::vector<RatedGame> games(game_count);
+    for (RatedGame& game : games) {
+        game.player = pick(gen);
+        do {
+            game.opponent = pick(gen);
+        } while (game.opponent == game.player);
+        game.score = coin(gen) < elo_expected_score(strength[game.player], strength[game.opponent]) ? 1.0 : 0.0;
+    }
+
+    std::cout << game_count << " games, " << players << " players, " << periods << " periods, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << "threads  seconds  games/s" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16}) {
+        std::vector<GlickoRating> ratings(players);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t p = 0; p < periods; ++p) {
+            size_t begin = game_count * p / periods;
+            size_t end = game_count * (p + 1) / periods;
+            glicko2_rating_period(ratings, std::span<const RatedGame>(games.data() + begin, end - begin), 0.5, threads);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << threads << "\t " << seconds << "\t  " << static_cast<uint64_t>(game_count / seconds) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "RatingEngine.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0; /**< The number of failed checks. */
+
+/**
+ * @brief Reports a failed check.
+ * @param ok Whether the check passed.
+ * @param what The description printed if it failed.
+ */
+static void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * @brief Builds a finished game the way the server's finish_game does.
+ * @param player The client's name.
+ * @param score The client's score.
+ * @return The game.
+ */
+static GameRecord make_game(const std::string& player, double score) {
+    GameRecord game;
+    game.player = player;
+    game.score = score;
+    game.rows = 6;
+    game.columns = 7;
+    game.win_condition = 4;
+    return game;
+}
+
+/**
+ * @brief Creates the settings of an empty database file in the temporary directory.
+ * @param name The file name.
+ * @return The settings.
+ */
+static DatabaseConfig fresh_database(const std::string& name) {
+    DatabaseConfig config;
+    config.path = (std::filesystem::temp_directory_path() / name).string();
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::remove((config.path + suffix).c_str());
+    }
+    return config;
+}
+
+/**
+ * @brief Checks that an Elo draw between unequally rated players moves both ratings towards each other.
+ */
+static void test_elo_draw() {
+    DatabaseManager db_manager(fresh_database("rating_test_elo.db"));
+    RatingConfig config;
+    RatingEngine ratings(db_manager, config);
+
+    // A loss first, so the draw is between unequal ratings.
+    ratings.record_result(make_game("drawer", 0.0));
+    db_manager.flush();
+    int player_before = db_manager.get_player_elo("drawer");
+    int server_before = db_manager.get_player_elo(RatingEngine::SERVER_NAME);
+    check(player_before < server_before, "the loss rates the server above the player");
+
+    ratings.record_result(make_game("drawer", 0.5));
+    db_manager.flush();
+    int player_after = db_manager.get_player_elo("drawer");
+    int server_after = db_manager.get_player_elo(RatingEngine::SERVER_NAME);
+    check(player_after > player_before, "the lower rated player gains from a draw");
+    check(server_after < server_before, "the higher rated server loses from a draw");
+    check(player_after - player_before == server_before - server_after, "an Elo draw moves both ratings by the same amount");
+    check(db_manager.get_player("drawer").games == 2, "the draw counts as a game");
+}
+
+/**
+ * @brief Checks that a Glicko-2 draw moves both ratings towards each other and makes both more certain.
+ */
+static void test_glicko2_draw() {
+    std::vector<GlickoRating> ratings(2);
+    ratings[0].rating = 300;
+    ratings[1].rating = 100;
+    std::vector<RatedGame> games = {{0, 1, 0.5}};
+    glicko2_rating_period(ratings, games, 0.5, 1);
+    check(ratings[0].rating < 300, "the higher rated player loses from a Glicko-2 draw");
+    check(ratings[1].rating > 100, "the lower rated player gains from a Glicko-2 draw");
+    check(ratings[0].deviation < 350 && ratings[1].deviation < 350, "a Glicko-2 draw shrinks both deviations");
+}
+
+/**
+ * @brief Checks that a recomputation reads an archived draw back and rates both players.
+ */
+static void test_glicko2_recompute_draw() {
+    DatabaseManager db_manager(fresh_database("rating_test_glicko2.db"));
+    RatingConfig config;
+    config.system = "glicko2";
+    config.threads = 1;
+    RatingEngine ratings(db_manager, config);
+
+    ratings.record_result(make_game("drawer", 0.0));
+    ratings.record_result(make_game("drawer", 0.5));
+    check(ratings.recompute() == 2, "both games are rated");
+
+    double total = 0;
+    db_manager.for_each_game([&](const char*, const char*, double score, int64_t) { total += score; });
+    check(total == 0.5, "the draw is archived with a score of 0.5");
+
+    PlayerRecord player = db_manager.get_player("drawer");
+    PlayerRecord server = db_manager.get_player(RatingEngine::SERVER_NAME);
+    check(player.deviation < 350 && server.deviation < 350, "the recomputation rates both players");
+    check(player.elo < 100 && server.elo > 100, "a loss and a draw leave the server ahead");
+}
+
+/**
+ * @brief Main function of the rating tests.
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main() {
+    test_elo_draw();
+    test_glicko2_draw();
+    test_glicko2_recompute_draw();
+    if (failures > 0) {
+        std::cerr << failures << " checks failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All rating checks passed." << std::endl;
+    return 0;
+}
@@ -2,22 +2,79 @@
 #include "websocketpp/server.hpp"
 #include "ConnectFourGame.h"
 #include "DatabaseManager.h"
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <functional>
 #include <json/json.h>
-#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
 #include <mutex>
-#include <condition_variable>
+#include <thread>
+#include <vector>
 #include "server.h"
 
 typedef websocketpp::server<websocketpp::config::asio> server;
 
+/**
+ * @brief Loads the configuration from a JSON file. Missing keys keep their defaults.
+ * @param path The path of the configuration file.
+ * @return The loaded configuration, or the defaults if the file cannot be read.
+ */
+ServerConfig ServerConfig::load(const std::string& path) {
+    ServerConfig config;
+    std::ifstream file(path);
+    if (!file) {
+        return config;
+    }
+
+    Json::Value root;
+    Json::CharReaderBuilder reader;
+    std::string errs;
+    if (!Json::parseFromStream(reader, file, &root, &errs)) {
+        std::cerr << "Failed to parse server config: " << errs << std::endl;
+        return config;
+    }
+
+    config.rows = root.get("rows", config.rows).asInt();
+    config.columns = root.get("columns", config.columns).asInt();
+    config.win_condition = root.get("win_condition", config.win_condition).asInt();
+    config.server_player = root.get("server_player", config.server_player).asString();
+    config.solver_depth = root.get("solver_depth", config.solver_depth).asInt();
+    config.table_size_mb = root.get("table_size_mb", config.table_size_mb).asInt();
+    config.solver_threads = root.get("solver_threads", config.solver_threads).asInt();
+    config.opening_book = root.get("opening_book", config.opening_book).asString();
+    config.io_threads = root.get("io_threads", config.io_threads).asInt();
+    config.move_threads = root.get("move_threads", config.move_threads).asInt();
+
+    const Json::Value& database = root["database"];
+    DatabaseConfig& db = config.database;
+    db.path = database.get("path", db.path).asString();
+    db.journal_mode = database.get("journal_mode", db.journal_mode).asString();
+    db.synchronous = database.get("synchronous", db.synchronous).asString();
+    db.cache_size_kb = database.get("cache_size_kb", db.cache_size_kb).asInt();
+    db.mmap_size_mb = database.get("mmap_size_mb", db.mmap_size_mb).asInt();
+    db.read_connections = database.get("read_connections", db.read_connections).asInt();
+    db.player_cache_size = database.get("player_cache_size", db.player_cache_size).asInt();
+
+    const Json::Value& rating = root["rating"];
+    RatingConfig& ratings = config.rating;
+    ratings.system = rating.get("system", ratings.system).asString();
+    ratings.k_factor = rating.get("k_factor", ratings.k_factor).asDouble();
+    ratings.tau = rating.get("tau", ratings.tau).asDouble();
+    ratings.period_days = rating.get("period_days", ratings.period_days).asInt();
+    ratings.recompute_hours = rating.get("recompute_hours", ratings.recompute_hours).asInt();
+    ratings.threads = rating.get("threads", ratings.threads).asInt();
+    return config;
+}
+
 /**
  * @brief Gets the instance of the ConnectFourServer.
  * @return The instance of the ConnectFourServer.
  */
-ConnectFourServer& ConnectFourServer::getInstance() {
+template <typename Game>
+ConnectFourServer<Game>& ConnectFourServer<Game>::getInstance() {
     static ConnectFourServer instance;
     return instance;
 }
@@ -25,22 +82,35 @@ ConnectFourServer& ConnectFourServer::getInstance() {
 /**
  * @brief Constructor for the ConnectFourServer class.
  */
-ConnectFourServer::ConnectFourServer() : current_player(Player::SERVER), client_connected(false), game_over(false) {}
+template <typename Game>
+ConnectFourServer<Game>::ConnectFourServer() {}
 
 /**
  * @brief Destructor for the ConnectFourServer class.
  */
-ConnectFourServer::~ConnectFourServer() {}
+template <typename Game>
+ConnectFourServer<Game>::~ConnectFourServer() {}
 
 
 /**
  * @brief Runs the server and begins listening for connections.
+ * @param config The server configuration.
  */
-void ConnectFourServer::run() {
+template <typename Game>
+void ConnectFourServer<Game>::run(const ServerConfig& config) {
+    this->config = config;
+    db_manager = std::make_unique<DatabaseManager>(config.database);
+    ratings = std::make_unique<RatingEngine>(*db_manager, config.rating);
+    table = std::make_unique<TranspositionTable>(config.table_size_mb);
+    if (book.open(config.opening_book, Game::ROWS, Game::COLUMNS, Game::WIN_CONDITION)) {
+        std::cout << "Loaded opening book with " << book.size() << " positions." << std::endl;
+    }
+
     ws_server.clear_access_channels(websocketpp::log::alevel::all);
     ws_server.set_access_channels(websocketpp::log::alevel::app);
     ws_server.clear_error_channels(websocketpp::log::elevel::all);
 
+    ws_server.set_validate_handler(bind(&ConnectFourServer::on_validate, this, std::placeholders::_1));
     ws_server.set_open_handler(bind(&ConnectFourServer::on_open, this, std::placeholders::_1));
     ws_server.set_close_handler(bind(&ConnectFourServer::on_close, this, std::placeholders::_1));
     ws_server.set_message_handler(bind(&ConnectFourServer::on_message, this, std::placeholders::_1, std::placeholders::_2));
@@ -49,16 +119,43 @@ void ConnectFourServer::run() {
     ws_server.listen(9002);
     ws_server.start_accept();
 
-    std::thread server_thread([this]() {
-        ws_server.run();
+    // Stopping the event loop lets run() return, and the rating writer then commits its queue on exit.
+    boost::asio::signal_set signals(ws_server.get_io_service(), SIGINT, SIGTERM);
+    signals.async_wait([this](const boost::system::error_code& error, int) {
+        if (!error) {
+            std::cout << "Shutting down..." << std::endl;
+            ws_server.stop_listening();
+            ws_server.stop();
+        }
     });
 
-    {
-        std::unique_lock<std::mutex> lock(connection_mutex);
-        connection_cv.wait(lock, [this] { return client_connected; });
+    int hardware_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int io_threads = config.io_threads > 0 ? config.io_threads : hardware_threads;
+    int move_threads = config.move_threads > 0 ? config.move_threads : hardware_threads;
+    workers = std::make_unique<boost::asio::thread_pool>(move_threads);
+    std::cout << "Serving connections on " << io_threads << " threads, computing moves on " << move_threads << "." << std::endl;
+    if (config.rating.system == "glicko2" && config.rating.recompute_hours > 0) {
+        rating_timer = std::make_unique<boost::asio::steady_timer>(ws_server.get_io_service());
+        schedule_rating_recompute();
     }
 
-    server_thread.join();
+    std::vector<std::thread> threads;
+    for (int i = 1; i < io_threads; ++i) {
+        threads.emplace_back([this]() {
+            ws_server.run();
+        });
+    }
+    ws_server.run();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    workers->stop();
+    workers->join();
+
+    const PlayerCache& cache = db_manager->player_cache();
+    std::cout << "Player cache: " << cache.hits() << " hits, " << cache.misses() << " misses, "
+              << cache.size() << " players." << std::endl;
 }
 
 /**
@@ -66,20 +163,300 @@ void ConnectFourServer::run() {
  * @param hdl The connection handle of the recipient.
  * @param message The JSON message to send.
  */
-void ConnectFourServer::send_json_message(websocketpp::connection_hdl hdl, const Json::Value& message) {
-    std::string message_str = Json::writeString(Json::StreamWriterBuilder(), message);
-    ws_server.send(hdl, message_str, websocketpp::frame::opcode::text);
+template <typename Game>
+void ConnectFourServer<Game>::send_json_message(websocketpp::connection_hdl hdl, const Json::Value& message) {
+    send_text_message(hdl, write_compact_json(message));
+}
+
+/**
+ * @brief Sends an already serialized JSON message to a specific client.
+ * @param hdl The connection handle of the recipient.
+ * @param message The serialized message.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_text_message(websocketpp::connection_hdl hdl, std::string_view message) {
+    websocketpp::lib::error_code ec;
+    ws_server.send(hdl, message.data(), message.size(), websocketpp::frame::opcode::text, ec);
+    if (ec) {
+        std::cerr << "Failed to send message: " << ec.message() << std::endl;
+    }
+}
+
+/**
+ * @brief Sends a binary frame to a specific client.
+ * @param hdl The connection handle of the recipient.
+ * @param frame The frame to send.
+ */
+template <typename Game>
+template <typename Frame>
+void ConnectFourServer<Game>::send_frame(websocketpp::connection_hdl hdl, const Frame& frame) {
+    auto bytes = encode_frame(frame);
+    websocketpp::lib::error_code ec;
+    ws_server.send(hdl, bytes.data(), bytes.size(), websocketpp::frame::opcode::binary, ec);
+}
+
+/**
+ * @brief Reports a move to the client, followed by the end of the game if the move won it.
+ * @param session The session the move was played in.
+ * @param player The player who moved.
+ * @param column The column played.
+ * @param win Whether the move won the game.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_move_result(Session& session, Player player, int column, bool win) {
+    const Game& game = session.game;
+    int row = Game::ROWS - game.column_height(column);
+    if (!session.binary) {
+        Json::Value response;
+        response["type"] = "move_result";
+        response["column"] = column;
+        response["row"] = row;
+        response["player"] = player;
+        response["seq"] = game.move_count();
+        response["win"] = win;
+        response["winner"] = win ? player : Player::NONE;
+        send_json_message(session.hdl, response);
+        return;
+    }
+
+    MoveResultFrame result;
+    result.column = static_cast<uint8_t>(column);
+    result.row = static_cast<uint8_t>(row);
+    result.player = static_cast<uint8_t>(player);
+    result.seq = static_cast<uint16_t>(game.move_count());
+    send_frame(session.hdl, result);
+
+    if (win) {
+        send_game_over(session, player);
+    }
+}
+
+/**
+ * @brief Tells the client that the game has ended, in JSON a game_over message and in binary a GameOverFrame.
+ * @param session The session of the client.
+ * @param winner The winning player, Player::NONE for a draw.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_game_over(Session& session, Player winner) {
+    if (!session.binary) {
+        Json::Value response;
+        response["type"] = "game_over";
+        response["winner"] = winner;
+        response["seq"] = session.game.move_count();
+        send_json_message(session.hdl, response);
+        return;
+    }
+
+    GameOverFrame game_over;
+    game_over.winner = static_cast<uint8_t>(winner);
+    game_over.seq = static_cast<uint16_t>(session.game.move_count());
+    send_frame(session.hdl, game_over);
+}
+
+/**
+ * @brief Sends the client a snapshot of the board.
+ * @param session The session of the client.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_board(Session& session) {
+    const Game& game = session.game;
+    if (!session.binary) {
+        Json::Value response;
+        response["type"] = "board";
+        response["seq"] = game.move_count();
+        response["board"] = game.get_board_json();
+        send_json_message(session.hdl, response);
+        return;
+    }
+
+    BoardFrame board;
+    board.rows = Game::ROWS;
+    board.columns = Game::COLUMNS;
+    board.seq = static_cast<uint16_t>(game.move_count());
+    board.cells.reserve(Game::ROWS * Game::COLUMNS);
+    for (int row = 0; row < Game::ROWS; ++row) {
+        for (int column = 0; column < Game::COLUMNS; ++column) {
+            board.cells.push_back(static_cast<uint8_t>(game.cell(row, column)));
+        }
+    }
+    send_frame(session.hdl, board);
+}
+
+/**
+ * @brief Tells the client that its move was rejected.
+ * @param session The session of the client.
+ * @param error The reason.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_move_error(Session& session, const std::string& error) {
+    if (!session.binary) {
+        Json::Value response;
+        response["type"] = "move_result";
+        response["error"] = error;
+        send_json_message(session.hdl, response);
+        return;
+    }
+
+    MoveResultFrame result;
+    result.status = MoveStatus::INVALID;
+    result.player = static_cast<uint8_t>(Player::CLIENT);
+    result.seq = static_cast<uint16_t>(session.game.move_count());
+    send_frame(session.hdl, result);
+}
+
+/**
+ * @brief Tells the client that it is to move.
+ * @param session The session of the client.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::send_your_turn(Session& session) {
+    if (session.binary) {
+        send_frame(session.hdl, YourTurnFrame());
+        return;
+    }
+
+    send_text_message(session.hdl, YOUR_TURN_MESSAGE);
+}
+
+/**
+ * @brief Starts computing the server's move on the worker pool.
+ * @param session The session to move in.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::make_server_move(Session& session) {
+    websocketpp::lib::error_code ec;
+    server::connection_ptr connection = ws_server.get_con_from_hdl(session.hdl, ec);
+    if (ec) {
+        return;
+    }
+
+    // The worker searches a copy, and the result is played on the connection's strand,
+    // so the session itself is never touched off the strand.
+    std::shared_ptr<Session> owner = session.shared_from_this();
+    boost::asio::post(*workers, [this, owner, connection, position = session.game]() {
+        int server_column = choose_server_move(position);
+        boost::asio::post(ws_server.get_io_service(), connection->get_strand()->wrap([this, owner, server_column]() {
+            play_server_move(*owner, server_column);
+        }));
+    });
+}
+
+/**
+ * @brief Picks the server's move from the opening book, the solver or the console.
+ * @param game The position to move in.
+ * @return The column to play.
+ */
+template <typename Game>
+int ConnectFourServer<Game>::choose_server_move(const Game& game) {
+    if (config.server_player == "console") {
+        return read_console_move(game);
+    }
+
+    int server_column;
+    int score;
+    if (book.lookup(game.canonical_hash(), server_column, score)) {
+        return game.canonical_column(server_column);
+    }
+    ParallelSolver<Game> solver(config.solver_threads, config.solver_depth, table.get());
+    return solver.best_move(game, Player::SERVER);
+}
+
+/**
+ * @brief Plays the server's move and reports it to the client.
+ * @param session The session to move in.
+ * @param server_column The column to play.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::play_server_move(Session& session, int server_column) {
+    if (session.game_over) {
+        return;
+    }
+
+    // The client may have started closing while the worker searched; on_close ends that game.
+    websocketpp::lib::error_code ec;
+    server::connection_ptr connection = ws_server.get_con_from_hdl(session.hdl, ec);
+    if (ec || connection->get_state() != websocketpp::session::state::open) {
+        return;
+    }
+
+    Game& game = session.game;
+    std::cout << "Making move for player " << Player::SERVER << " in column " << server_column << std::endl;
+    if (server_column < 0 || !game.make_move(Player::SERVER, server_column)) {
+        // Only a full board leaves the server without a move, and the client's move already ended that game.
+        std::cerr << "Invalid server move: " << server_column << std::endl;
+        finish_if_drawn(session);
+        return;
+    }
+
+    game.print_board();
+    bool win = game.check_winner(Player::SERVER);
+    send_move_result(session, Player::SERVER, server_column, win);
+
+    if (win) {
+        std::cout << "Server wins against " << session.player_name << "!" << std::endl;
+        finish_game(session, 0.0);
+        return;
+    }
+    if (finish_if_drawn(session)) {
+        return;
+    }
+
+    session.current_player = Player::CLIENT;
+    send_your_turn(session);
+    std::cout << "Waiting for " << session.player_name << " to make a move..." << std::endl;
+}
+
+/**
+ * @brief Ends a session's game, archiving and rating it.
+ * @param session The session whose game ended.
+ * @param score The client's score: 1 for a win, 0.5 for a draw, 0 for a loss.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::finish_game(Session& session, double score) {
+    session.game_over = true;
+
+    GameRecord record;
+    record.player = session.player_name;
+    record.score = score;
+    record.started_at = session.started_at;
+    record.rows = Game::ROWS;
+    record.columns = Game::COLUMNS;
+    record.win_condition = Game::WIN_CONDITION;
+    record.move_count = session.game.move_count();
+    record.moves = GameRecord::pack_moves(session.game.move_history(), Game::COLUMNS);
+    ratings->record_result(std::move(record));
+}
+
+/**
+ * @brief Ends a session's game as a draw if its board is full.
+ * @param session The session that just moved.
+ * @return True if the game was drawn, false if it goes on.
+ */
+template <typename Game>
+bool ConnectFourServer<Game>::finish_if_drawn(Session& session) {
+    if (session.game_over || !session.game.is_full()) {
+        return false;
+    }
+
+    std::cout << "The game against " << session.player_name << " is a draw." << std::endl;
+    send_game_over(session, Player::NONE);
+    finish_game(session, 0.5);
+    return true;
 }
 
 /**
- * @brief Makes a move for the server.
+ * @brief Reads the server's move from the console until a valid column is entered.
+ * @param game The position to move in.
+ * @return The column entered.
  */
-void ConnectFourServer::make_server_move() {
+template <typename Game>
+int ConnectFourServer<Game>::read_console_move(Game game) {
+    std::lock_guard<std::mutex> lock(console_mutex);
     int server_column;
     std::string input;
 
     while (true) {
-        std::cout << "It's your turn! Enter column (0-6) to drop your disc: ";
+        std::cout << "It's your turn! Enter column (0-" << Game::COLUMNS - 1 << ") to drop your disc: ";
         std::cin >> input;
 
         try {
@@ -87,82 +464,80 @@ void ConnectFourServer::make_server_move() {
             if (!game.make_move(Player::SERVER, server_column)) {
                 throw std::runtime_error("Column is full or out of bounds. Please try a different column.");
             }
-            break;
+            return server_column;
         } catch (const std::invalid_argument& e) {
             std::cerr << "Invalid column value!" << std::endl;
         } catch (const std::runtime_error& e) {
             std::cerr << e.what() << std::endl;
         }
     }
+}
 
-    game.print_board();
-    bool win = game.check_winner(Player::SERVER);
-
-    Json::Value response;
-    response["type"] = "move_result";
-    response["win"] = win;
-    response["winner"] = win ? Player::SERVER : Player::NONE;
-    response["board"] = game.get_board_json();
-    send_json_message(client_hdl, response);
+/**
+ * @brief Recomputes the Glicko-2 ratings on the worker pool every rating.recompute_hours hours.
+ */
+template <typename Game>
+void ConnectFourServer<Game>::schedule_rating_recompute() {
+    rating_timer->expires_after(std::chrono::hours(config.rating.recompute_hours));
+    rating_timer->async_wait([this](const boost::system::error_code& error) {
+        if (error) {
+            return;
+        }
+        boost::asio::post(*workers, [this]() {
+            auto start = std::chrono::steady_clock::now();
+            size_t games = ratings->recompute();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Recomputed ratings from " << games << " games in " << seconds << " s." << std::endl;
+        });
+        schedule_rating_recompute();
+    });
+}
 
-    if (win) {
-        std::cout << "Server wins!" << std::endl;
-        db_manager.update_or_insert_player_elo(player_name, -1);
-        game_over = true;
-        return;
+/**
+ * @brief Accepts a WebSocket handshake, selecting BINARY_SUBPROTOCOL if the client offers it.
+ * @param hdl The connection handle.
+ * @return True, every handshake is accepted.
+ */
+template <typename Game>
+bool ConnectFourServer<Game>::on_validate(websocketpp::connection_hdl hdl) {
+    server::connection_ptr connection = ws_server.get_con_from_hdl(hdl);
+    for (const std::string& subprotocol : connection->get_requested_subprotocols()) {
+        if (subprotocol == BINARY_SUBPROTOCOL) {
+            connection->select_subprotocol(subprotocol);
+            break;
+        }
     }
-
-    current_player = Player::CLIENT;
-    Json::Value turn_notification;
-    turn_notification["type"] = "your_turn";
-    send_json_message(client_hdl, turn_notification);
-    std::cout << "Waiting for client to make a move..." << std::endl;
+    return true;
 }
 
 /**
  * @brief Handles a new WebSocket connection.
  * @param hdl The connection handle.
  */
-void ConnectFourServer::on_open(websocketpp::connection_hdl hdl) {
-    std::lock_guard<std::mutex> lock(connection_mutex);
-
-    if (client_connected) {
-        std::cout << "A client is already connected. Closing new connection." << std::endl;
-        ws_server.close(hdl, websocketpp::close::status::normal, "Another client is already connected.");
-        return;
-    }
-
-    std::cout << "New client connected. Waiting for player name..." << std::endl << std::flush;
-
-    client_connected = true;
-    client_hdl = hdl;
-    connection_cv.notify_one();
-
-    current_player = Player::SERVER;
-    game = ConnectFourGame();
-    game_over = false;
+template <typename Game>
+void ConnectFourServer<Game>::on_open(websocketpp::connection_hdl hdl) {
+    auto session = std::make_shared<Session>();
+    session->hdl = hdl;
+    session->binary = ws_server.get_con_from_hdl(hdl)->get_subprotocol() == BINARY_SUBPROTOCOL;
+
+    size_t count = sessions.insert(hdl, session);
+    std::cout << "New client connected (" << count << " active). Waiting for player name..." << std::endl;
 }
 
 /**
  * @brief Handles a WebSocket connection closure.
  * @param hdl The connection handle.
  */
-void ConnectFourServer::on_close(websocketpp::connection_hdl hdl) {
-    std::lock_guard<std::mutex> lock(connection_mutex);
-
-    auto current_client = client_hdl.lock();
-    auto closing_client = hdl.lock();
-
-    if (current_client && closing_client && current_client == closing_client) {
-        client_connected = false;
+template <typename Game>
+void ConnectFourServer<Game>::on_close(websocketpp::connection_hdl hdl) {
+    std::shared_ptr<Session> session = sessions.erase(hdl);
+    if (!session) {
+        return;
+    }
 
-        if (!game_over) {
-            std::cout << "Client disconnected. Treating as a loss for the client." << std::endl;
-            db_manager.update_or_insert_player_elo(player_name, -1);
-            game_over = true;
-        }
-    } else {
-        std::cout << "Rejected connection closed." << std::endl;
+    if (!session->game_over && !session->player_name.empty()) {
+        std::cout << session->player_name << " disconnected. Treating as a loss for the client." << std::endl;
+        finish_game(*session, 0.0);
     }
 }
 
@@ -171,95 +546,150 @@ void ConnectFourServer::on_close(websocketpp::connection_hdl hdl) {
  * @param hdl The connection handle.
  * @param msg The received message.
  */
-void ConnectFourServer::on_message(websocketpp::connection_hdl hdl, server::message_ptr msg) {
-    std::lock_guard<std::mutex> lock(connection_mutex);
-    if (!client_connected) {
+template <typename Game>
+void ConnectFourServer<Game>::on_message(websocketpp::connection_hdl hdl, server::message_ptr msg) {
+    std::shared_ptr<Session> session = sessions.find(hdl);
+    if (!session) {
         std::cerr << "Received message after client disconnected. Ignoring message." << std::endl;
         return;
     }
 
+    if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+        MoveFrame move;
+        if (decode_frame(msg->get_payload(), move)) {
+            if (session->current_player == Player::CLIENT && !session->game_over) {
+                handle_client_move(*session, move.column);
+            }
+        } else if (frame_type(msg->get_payload()) == FrameType::BOARD_REQUEST) {
+            if (!session->player_name.empty()) {
+                send_board(*session);
+            }
+        } else {
+            std::cerr << "Failed to parse binary frame." << std::endl;
+        }
+        return;
+    }
+
+    // Moves are by far the most common message, so they skip the Json::Value tree.
+    const std::string& payload = msg->get_payload();
+    int column;
+    if (parse_move_message(payload, column)) {
+        if (session->current_player == Player::CLIENT && !session->game_over) {
+            handle_client_move(*session, column);
+        }
+        return;
+    }
+
     Json::Value root;
-    Json::CharReaderBuilder reader;
     std::string errs;
-    std::istringstream stream(msg->get_payload());
-    if (!Json::parseFromStream(reader, stream, &root, &errs)) {
+    if (!parse_json(payload, root, &errs)) {
         std::cerr << "Failed to parse message: " << errs << std::endl;
         return;
     }
 
     std::string message_type = root["type"].asString();
-    if (message_type == "player_name") {
-        handle_player_name(root["name"].asString());
-    } else if (message_type == "move" && current_player == Player::CLIENT) {
-        handle_client_move(root["column"].asString());
+    if (message_type == "player_name" && session->player_name.empty()) {
+        handle_player_name(*session, root["name"].asString());
+    } else if (message_type == "move" && session->current_player == Player::CLIENT && !session->game_over) {
+        try {
+            column = std::stoi(root["column"].asString());
+        } catch (const std::exception&) {
+            column = -1;
+        }
+        handle_client_move(*session, column);
+    } else if (message_type == "board_request" && !session->player_name.empty()) {
+        send_board(*session);
     }
 }
 
 /**
  * @brief Handles a player's name.
+ * @param session The session of the player.
  * @param player_name The name of the player.
  */
-void ConnectFourServer::handle_player_name(const std::string& player_name) {
-    this->player_name = player_name;
+template <typename Game>
+void ConnectFourServer<Game>::handle_player_name(Session& session, const std::string& player_name) {
+    session.player_name = player_name;
+    session.started_at = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
     std::cout << "Player name received: " << player_name << std::endl;
+    if (session.binary) {
+        GameStartFrame start;
+        start.rows = Game::ROWS;
+        start.columns = Game::COLUMNS;
+        start.win_condition = Game::WIN_CONDITION;
+        send_frame(session.hdl, start);
+    } else {
+        send_text_message(session.hdl, GAME_START_MESSAGE);
+    }
+    send_board(session);
 
-    int elo = db_manager.get_player_elo(player_name);
-    if (elo != -1) {
-        std::cout << "Player " << player_name << " has an ELO of " << elo << "." << std::endl;
+    PlayerRecord player = db_manager->get_player(player_name);
+    if (player.known) {
+        std::cout << "Player " << player_name << " has a rating of " << player.elo;
+        if (config.rating.system == "glicko2") {
+            std::cout << " +/- " << static_cast<int>(2 * player.deviation);
+        }
+        std::cout << " after " << player.games << " games." << std::endl;
     } else {
-        std::cout << "Player " << player_name << " is new. Starting ELO is 100." << std::endl;
+        std::cout << "Player " << player_name << " is new. Starting rating is " << player.elo << "." << std::endl;
     }
 
-    make_server_move();
+    make_server_move(session);
 }
 
 
 /**
  * @brief Handles a client move.
- * @param column The column to place the piece.
+ * @param session The session of the client.
+ * @param column The column to place the piece, -1 if the client sent no valid column.
  */
-void ConnectFourServer::handle_client_move(const std::string& column) {
-    int client_column;
-    Json::Value response;
-    response["type"] = "move_result";
-
-    try {
-        client_column = std::stoi(column);
-        if (!game.make_move(Player::CLIENT, client_column)) {
-            throw std::runtime_error("Invalid move. Please try a different column.");
-        }
-    } catch (std::exception& e) {
+template <typename Game>
+void ConnectFourServer<Game>::handle_client_move(Session& session, int column) {
+    Game& game = session.game;
+    std::cout << "Making move for player " << Player::CLIENT << " in column " << column << std::endl;
+    if (column < 0 || !game.make_move(Player::CLIENT, column)) {
         std::cerr << "Invalid client move: " << column << std::endl;
-        response["error"] = e.what();
-        send_json_message(client_hdl, response);
+        send_move_error(session, "Invalid move. Please try a different column.");
         return;
     }
 
     game.print_board();
     bool win = game.check_winner(Player::CLIENT);
-
-    response["win"] = win;
-    response["winner"] = win ? Player::CLIENT : Player::NONE;
-    response["board"] = game.get_board_json();
-    send_json_message(client_hdl, response);
+    send_move_result(session, Player::CLIENT, column, win);
 
     if (win) {
-        std::cout << "Client wins!" << std::endl;
-        db_manager.update_or_insert_player_elo(player_name, 1);
-        game_over = true;
+        std::cout << session.player_name << " wins!" << std::endl;
+        finish_game(session, 1.0);
+        return;
+    }
+    if (finish_if_drawn(session)) {
         return;
     }
 
-    current_player = Player::SERVER;
-    make_server_move();
+    session.current_player = Player::SERVER;
+    make_server_move(session);
 }
 
 /**
  * @brief Main function to start the game server.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments. The optional first one is the path of the configuration file.
  * @return Exit status of the program.
  */
-int main() {
-    ConnectFourServer& server = ConnectFourServer::getInstance();
-    server.run();
+int main(int argc, char* argv[]) {
+    ServerConfig config = ServerConfig::load(argc > 1 ? argv[1] : "server_config.json");
+
+    bool supported = dispatch_game_variant(config.rows, config.columns, config.win_condition, [&config](auto variant) {
+        using Game = typename decltype(variant)::type;
+        std::cout << "Playing connect-" << Game::WIN_CONDITION << " on a "
+                  << Game::ROWS << "x" << Game::COLUMNS << " board." << std::endl;
+        ConnectFourServer<Game>::getInstance().run(config);
+    });
+
+    if (!supported) {
+        std::cerr << "Unsupported board: " << config.rows << "x" << config.columns
+                  << " with " << config.win_condition << " in a row." << std::endl;
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
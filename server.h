@@ -3,19 +3,78 @@
 
 #include "websocketpp/config/asio_no_tls.hpp"
 #include "websocketpp/server.hpp"
+#include <boost/asio/post.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include "BinaryProtocol.h"
 #include "ConnectFourGame.h"
 #include "DatabaseManager.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "OpeningBook.h"
+#include "ParallelSolver.h"
+#include "RatingEngine.h"
+#include "SessionRegistry.h"
 #include <string>
+#include <string_view>
+#include <memory>
 #include <mutex>
-#include <condition_variable>
 #include <json/json.h>
 
 typedef websocketpp::server<websocketpp::config::asio> server;
 
+/**
+ * @struct ServerConfig
+ * @brief Runtime settings of the server, read from a JSON configuration file.
+ */
+struct ServerConfig {
+    int rows = 6; /**< The number of rows on the board. */
+    int columns = 7; /**< The number of columns on the board. */
+    int win_condition = 4; /**< The number of discs in a row needed to win. */
+    std::string server_player = "solver"; /**< Who picks the server's moves: "solver" or "console". */
+    int solver_depth = 12; /**< The solver's look-ahead in plies, 0 to always solve to the end of the game. */
+    int table_size_mb = 64; /**< The size of the solver's shared transposition table in megabytes. */
+    int solver_threads = 1; /**< The number of threads searching each server move. */
+    std::string opening_book = "opening_book.bin"; /**< The path of the opening book, used if the file exists. */
+    int io_threads = 0; /**< The number of threads serving connections, 0 for one per hardware thread. */
+    int move_threads = 0; /**< The number of threads computing server moves, 0 for one per hardware thread. */
+    DatabaseConfig database; /**< The settings of the rating database, read from the "database" object. */
+    RatingConfig rating; /**< The settings of the rating system, read from the "rating" object. */
+
+    /**
+     * @brief Loads the configuration from a JSON file. Missing keys keep their defaults.
+     * @param path The path of the configuration file.
+     * @return The loaded configuration, or the defaults if the file cannot be read.
+     */
+    static ServerConfig load(const std::string& path);
+};
+
 /**
  * @class ConnectFourServer
  * @brief A WebSocket server that manages Connect Four game sessions.
+ *
+ * Every connection gets its own session with its own game, so one server hosts any
+ * number of games at once. All sessions share the solver's transposition table and
+ * the opening book.
+ *
+ * Several threads run the asio event loop. websocketpp wraps each connection's
+ * handlers in that connection's strand, so a session is only ever touched by one
+ * thread at a time while different sessions are served in parallel. The session
+ * table is sharded, so looking a session up rarely waits on other connections.
+ *
+ * Server moves are searched, or read from the console, on a separate worker pool and
+ * played back on the connection's strand, so a slow move never stalls an I/O thread.
+ *
+ * Clients that offer BINARY_SUBPROTOCOL get the fixed-layout frames of BinaryProtocol.h;
+ * all others get JSON messages.
+ * In both protocols a move_result only carries the move and its sequence number, and
+ * clients keep their own board. The whole board is only sent when a game starts and when
+ * a client asks for it with a board_request, e.g. after missing a move. A won game ends
+ * with the winning move_result in JSON, and a drawn one with a game_over message.
+ * @tparam Game The ConnectFourGame variant played on this server.
  */
+template <typename Game>
 class ConnectFourServer {
 public:
     /**
@@ -26,10 +85,25 @@ public:
 
     /**
      * @brief Starts the server and begins listening for connections.
+     * @param config The server configuration.
      */
-    void run();
+    void run(const ServerConfig& config);
 
 private:
+    /**
+     * @struct Session
+     * @brief The state of the game played over one connection.
+     */
+    struct Session : std::enable_shared_from_this<Session> {
+        websocketpp::connection_hdl hdl; /**< The client's connection handle. */
+        Game game; /**< The game being played. */
+        Player current_player = Player::SERVER; /**< The player to move. */
+        bool game_over = false; /**< Whether the game has ended. */
+        std::string player_name; /**< The client's player name, empty until received. */
+        int64_t started_at = 0; /**< The Unix time the game started. */
+        bool binary = false; /**< Whether the connection negotiated BINARY_SUBPROTOCOL. */
+    };
+
     /**
      * @brief Constructor for the ConnectFourServer class.
      */
@@ -44,6 +118,9 @@ private:
     ConnectFourServer(const ConnectFourServer&) = delete;
     ConnectFourServer& operator=(const ConnectFourServer&) = delete;
 
+    static constexpr std::string_view YOUR_TURN_MESSAGE = R"({"type":"your_turn"})"; /**< The your_turn message, serialized once. */
+    static constexpr std::string_view GAME_START_MESSAGE = R"({"type":"game_start"})"; /**< The game_start message, serialized once. */
+
     /**
      * @brief Sends a JSON message to a client.
      * @param hdl The connection handle.
@@ -52,9 +129,107 @@ private:
     void send_json_message(websocketpp::connection_hdl hdl, const Json::Value& message);
 
     /**
-     * @brief Makes a server move.
+     * @brief Sends an already serialized JSON message to a client.
+     * @param hdl The connection handle.
+     * @param message The serialized message.
+     */
+    void send_text_message(websocketpp::connection_hdl hdl, std::string_view message);
+
+    /**
+     * @brief Sends a binary frame to a client.
+     * @param hdl The connection handle.
+     * @param frame The frame to send.
+     */
+    template <typename Frame>
+    void send_frame(websocketpp::connection_hdl hdl, const Frame& frame);
+
+    /**
+     * @brief Reports a move to the client, followed by the end of the game if the move won it.
+     * @param session The session the move was played in.
+     * @param player The player who moved.
+     * @param column The column played.
+     * @param win Whether the move won the game.
+     */
+    void send_move_result(Session& session, Player player, int column, bool win);
+
+    /**
+     * @brief Tells the client that the game has ended, in JSON a game_over message and in binary a GameOverFrame.
+     * @param session The session of the client.
+     * @param winner The winning player, Player::NONE for a draw.
+     */
+    void send_game_over(Session& session, Player winner);
+
+    /**
+     * @brief Sends the client a snapshot of the board.
+     * @param session The session of the client.
+     */
+    void send_board(Session& session);
+
+    /**
+     * @brief Tells the client that its move was rejected.
+     * @param session The session of the client.
+     * @param error The reason.
+     */
+    void send_move_error(Session& session, const std::string& error);
+
+    /**
+     * @brief Tells the client that it is to move.
+     * @param session The session of the client.
+     */
+    void send_your_turn(Session& session);
+
+    /**
+     * @brief Starts computing the server's move on the worker pool.
+     * @param session The session to move in.
+     */
+    void make_server_move(Session& session);
+
+    /**
+     * @brief Picks the server's move from the opening book, the solver or the console.
+     * @param game The position to move in.
+     * @return The column to play.
+     */
+    int choose_server_move(const Game& game);
+
+    /**
+     * @brief Plays the server's move and reports it to the client.
+     * @param session The session to move in.
+     * @param server_column The column to play.
+     */
+    void play_server_move(Session& session, int server_column);
+
+    /**
+     * @brief Ends a session's game, archiving and rating it.
+     * @param session The session whose game ended.
+     * @param score The client's score: 1 for a win, 0.5 for a draw, 0 for a loss.
+     */
+    void finish_game(Session& session, double score);
+
+    /**
+     * @brief Ends a session's game as a draw if its board is full.
+     * @param session The session that just moved.
+     * @return True if the game was drawn, false if it goes on.
+     */
+    bool finish_if_drawn(Session& session);
+
+    /**
+     * @brief Reads the server's move from the console until a valid column is entered.
+     * @param game The position to move in.
+     * @return The column entered.
+     */
+    int read_console_move(Game game);
+
+    /**
+     * @brief Recomputes the Glicko-2 ratings on the worker pool every rating.recompute_hours hours.
+     */
+    void schedule_rating_recompute();
+
+    /**
+     * @brief Accepts a WebSocket handshake, selecting BINARY_SUBPROTOCOL if the client offers it.
+     * @param hdl The connection handle.
+     * @return True, every handshake is accepted.
      */
-    void make_server_move();
+    bool on_validate(websocketpp::connection_hdl hdl);
 
     /**
      * @brief Handles new WebSocket connection requests.
@@ -77,26 +252,28 @@ private:
 
     /**
      * @brief Handles a player's name.
+     * @param session The session of the player.
      * @param player_name The name of the player.
      */
-    void handle_player_name(const std::string& player_name);
+    void handle_player_name(Session& session, const std::string& player_name);
 
     /**
      * @brief Handles a client move.
-     * @param column The column to place the piece.
+     * @param session The session of the client.
+     * @param column The column to place the piece, -1 if the client sent no valid column.
      */
-    void handle_client_move(const std::string& column);
+    void handle_client_move(Session& session, int column);
 
     server ws_server; /**< The WebSocket server instance. */
-    Player current_player;
-    bool client_connected;
-    bool game_over;
-    std::mutex connection_mutex;
-    std::condition_variable connection_cv;
-    websocketpp::connection_hdl client_hdl;
-    ConnectFourGame game; /**< The current game instance. */
-    std::string player_name;
-    DatabaseManager db_manager; /**< Database manager for player ratings. */
+    SessionRegistry<Session> sessions; /**< The sessions by connection. */
+    std::mutex console_mutex; /**< Lets one session at a time read a move from the console. */
+    std::unique_ptr<boost::asio::thread_pool> workers; /**< The threads computing server moves. */
+    std::unique_ptr<DatabaseManager> db_manager; /**< Database manager for player ratings. */
+    std::unique_ptr<RatingEngine> ratings; /**< Turns game results into ratings. */
+    std::unique_ptr<boost::asio::steady_timer> rating_timer; /**< Fires the periodic Glicko-2 recomputation. */
+    ServerConfig config; /**< The server configuration. */
+    std::unique_ptr<TranspositionTable> table; /**< The transposition table shared by all solvers. */
+    OpeningBook book; /**< The solved opening positions, looked up before searching. */
 };
 
 #endif // CONNECTFOURSERVER_H 
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "SessionRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct BenchSession
+ * @brief Stands in for the server's per-connection state.
+ */
+struct BenchSession {
+    std::atomic<int> moves{0}; /**< Touched on every lookup so the session is really used; threads share sessions, so it is atomic. */
+};
+
+/**
+ * @class GlobalRegistry
+ * @brief The single-lock session table the server used before sharding, for comparison.
+ */
+class GlobalRegistry {
+public:
+    /**
+     * @brief Adds the session of a connection.
+     * @param hdl The connection handle.
+     * @param session The session.
+     * @return The number of sessions after the insertion.
+     */
+    size_t insert(websocketpp::connection_hdl hdl, std::shared_ptr<BenchSession> session) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sessions[hdl] = std::move(session);
+        return sessions.size();
+    }
+
+    /**
+     * @brief Gets the session of a connection.
+     * @param hdl The connection handle.
+     * @return The session, or nullptr if the connection has none.
+     */
+    std::shared_ptr<BenchSession> find(websocketpp::connection_hdl hdl) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(hdl);
+        return it == sessions.end() ? nullptr : it->second;
+    }
+
+    /**
+     * @brief Removes the session of a connection.
+     * @param hdl The connection handle.
+     * @return The removed session, or nullptr if the connection had none.
+     */
+    std::shared_ptr<BenchSession> erase(websocketpp::connection_hdl hdl) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(hdl);
+        if (it == sessions.end()) {
+            return nullptr;
+        }
+        std::shared_ptr<BenchSession> session = std::move(it->second);
+        sessions.erase(it);
+        return session;
+    }
+
+private:
+    mutable std::mutex mutex; /**< Guards the whole table. */
+    std::map<websocketpp::connection_hdl, std::shared_ptr<BenchSession>, std::owner_less<websocketpp::connection_hdl>> sessions; /**< The sessions by connection. */
+};
+
+/**
+ * @brief Runs the synthetic load: every thread looks sessions up as messages arrive,
+ *        and one operation in sixteen is a disconnect followed by a reconnect.
+ * @param registry The session table under test.
+ * @param connections The connections, all of them registered.
+ * @param threads The number of threads.
+ * @param operations The number of operations per thread.
+ * @return The total number of operations per second.
+ */
+template <typename Registry>
+double run_load(Registry& registry, const std::vector<std::shared_ptr<void>>& connections, int threads, int operations) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&registry, &connections, operations, t]() {
+            std::mt19937_64 gen(t + 1);
+            std::uniform_int_distribution<size_t> pick(0, connections.size() - 1);
+            for (int i = 0; i < operations; ++i) {
+                websocketpp::connection_hdl hdl = connections[pick(gen)];
+                if ((i & 15) == 15) {
+                    if (auto session = registry.erase(hdl)) {
+                        registry.insert(hdl, session);
+                    }
+                } else if (auto session = registry.find(hdl)) {
+                    session->moves.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * static_cast<double>(operations) / seconds;
+}
+
+/**
+ * @brief Main function of the session table benchmark.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments. The optional first one is the number of sessions, 10000 by default.
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    int session_count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    constexpr int operations = 1000000;
+
+    std::vector<std::shared_ptr<void>> connections;
+    GlobalRegistry global;
+    SessionRegistry<BenchSession> sharded;
+    for (int i = 0; i < session_count; ++i) {
+        connections.push_back(std::make_shared<int>(i));
+        global.insert(connections.back(), std::make_shared<BenchSession>());
+        sharded.insert(connections.back(), std::make_shared<BenchSession>());
+    }
+
+    std::cout << session_count << " sessions, " << operations << " operations per thread, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << "threads  global lock (Mops/s)  sharded (Mops/s)" << std::endl;
+    for (int threads : {1, 2, 4, 8, 16}) {
+        double global_rate = run_load(global, connections, threads, operations);
+        double sharded_rate = run_load(sharded, connections, threads, operations);
+        std::cout << threads << "\t " << global_rate / 1e6 << "\t\t       " << sharded_rate / 1e6 << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "ParallelSolver.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * @brief Reports how long the parallel solver takes to pick the opening move for each
+ * look-ahead depth and thread count.
+ * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments. The optional first one is the deepest depth to time.
+ * @return Exit status of the program.
+ */
+int main(int argc, char* argv[]) {
+    const int max_depth = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int thread_counts[] = {1, 2, 4, 8, 16};
+    TranspositionTable table(64);
+
+    std::cout << "depth";
+    for (int threads : thread_counts) {
+        std::cout << std::setw(12) << threads << "T";
+    }
+    std::cout << "   (ms to pick the opening move on an empty 6x7 board)" << std::endl;
+
+    for (int depth = 8; depth <= max_depth; depth += 2) {
+        std::cout << std::setw(5) << depth;
+        for (int threads : thread_counts) {
+            table.clear();
+            StandardConnectFour game;
+            ParallelSolver<StandardConnectFour> solver(threads, depth, &table);
+
+            auto start = std::chrono::steady_clock::now();
+            solver.best_move(game, Player::SERVER);
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << std::setw(13) << std::fixed << std::setprecision(1) << elapsed;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "ConnectFourGame.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using Game = StandardConnectFour;
+constexpr int ROWS = Game::ROWS;
+constexpr int COLUMNS = Game::COLUMNS;
+constexpr int WIN_CONDITION = Game::WIN_CONDITION;
+
+/**
+ * @struct BenchPosition
+ * @brief A random game position together with the same position on a 2D grid.
+ */
+struct BenchPosition {
+    Game game; /**< The position as played through ConnectFourGame. */
+    std::vector<std::vector<int>> grid; /**< The position on a grid, row 0 being the top row. */
+    Player last_player; /**< The player who dropped the last disc. */
+    int last_row; /**< The row index of the last disc. */
+    int last_col; /**< The column index of the last disc. */
+};
+
+/**
+ * @brief Checks a specific direction for a win condition starting from a given position.
+ *
+ * This is the scalar win check that ConnectFourGame used before the bitboard kernel,
+ * kept here as the baseline of the benchmark.
+ * @param grid The game board.
+ * @param player The player to check for a win condition.
+ * @param row The starting row index.
+ * @param column The starting column index.
+ * @param d_row The row direction to check.
+ * @param d_col The column direction to check.
+ * @return True if a win condition is met in the specified direction, false otherwise.
+ */
+static bool check_direction(const std::vector<std::vector<int>>& grid, Player player, int row, int column, int d_row, int d_col) {
+    int count = 0;
+    for (int i = -WIN_CONDITION + 1; i < WIN_CONDITION; ++i) {
+        int r = row + i * d_row;
+        int c = column + i * d_col;
+        if (r >= 0 && r < ROWS && c >= 0 && c < COLUMNS && grid[r][c] == player) {
+            if (++count == WIN_CONDITION) return true;
+        } else {
+            count = 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks the four lines through a position with the scalar baseline.
+ * @param p The benchmark position.
+ * @return True if the last move won the game, false otherwise.
+ */
+static bool scalar_check(const BenchPosition& p) {
+    return check_direction(p.grid, p.last_player, p.last_row, p.last_col, 1, 0) ||
+           check_direction(p.grid, p.last_player, p.last_row, p.last_col, 0, 1) ||
+           check_direction(p.grid, p.last_player, p.last_row, p.last_col, 1, 1) ||
+           check_direction(p.grid, p.last_player, p.last_row, p.last_col, 1, -1);
+}
+
+/**
+ * @brief Plays random games and keeps every position reached along the way.
+ * @param count The number of positions to generate.
+ * @return The generated positions.
+ */
+static std::vector<BenchPosition> generate_positions(size_t count) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> dis(0, COLUMNS - 1);
+    std::vector<BenchPosition> positions;
+
+    while (positions.size() < count) {
+        BenchPosition p{Game(), std::vector<std::vector<int>>(ROWS, std::vector<int>(COLUMNS, Player::NONE)), Player::NONE, -1, -1};
+        std::vector<int> heights(COLUMNS, 0);
+        Player player = Player::SERVER;
+
+        for (int moves = 0; moves < ROWS * COLUMNS && positions.size() < count; ++moves) {
+            int column = dis(gen);
+            if (!p.game.make_move(player, column))
+                continue;
+            p.last_player = player;
+            p.last_row = ROWS - 1 - heights[column]++;
+            p.last_col = column;
+            p.grid[p.last_row][column] = player;
+            positions.push_back(p);
+
+            if (p.game.check_winner(player))
+                break;
+            player = player == Player::SERVER ? Player::CLIENT : Player::SERVER;
+        }
+    }
+    return positions;
+}
+
+/**
+ * @brief Times a win check over all positions.
+ * @param name The name printed in the report.
+ * @param positions The benchmark positions.
+ * @param rounds How many times to check every position.
+ * @param check The win check to time.
+ * @return The number of winning positions seen, to keep the work observable.
+ */
+template <typename Check>
+static size_t run(const char* name, const std::vector<BenchPosition>& positions, int rounds, Check check) {
+    size_t wins = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const auto& p : positions) {
+            wins += check(p);
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed / (double(rounds) * positions.size()) << " ns/check" << std::endl;
+    return wins;
+}
+
+/**
+ * @brief Compares the scalar, whole-position and incremental win checks.
+ * @return Exit status of the program.
+ */
+int main() {
+    const int rounds = 200;
+    std::vector<BenchPosition> positions = generate_positions(100000);
+
+    size_t scalar = run("scalar check_direction", positions, rounds, scalar_check);
+    size_t full = run("bitboard check_winner  ", positions, rounds, [](const BenchPosition& p) {
+        return p.game.check_winner(p.last_player);
+    });
+    size_t incremental = run("bitboard last_move_wins", positions, rounds, [](const BenchPosition& p) {
+        return p.game.last_move_wins();
+    });
+
+    if (scalar != full || scalar != incremental) {
+        std::cerr << "Win checks disagree: " << scalar << " / " << full << " / " << incremental << std::endl;
+        return 1;
+    }
+    return 0;
+}